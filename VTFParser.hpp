@@ -6,3 +6,10 @@
 namespace VtfParser {}
 
 #include "src/vtf.hpp"
+#include "src/catalog.hpp"
+#include "src/instrumentation.hpp"
+#include "src/codec.hpp"
+#include "src/resampler.hpp"
+#include "src/writer.hpp"
+#include "src/thumbnails.hpp"
+#include "src/colour-space.hpp"
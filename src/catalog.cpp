@@ -0,0 +1,158 @@
+#include "catalog.hpp"
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <ranges>
+#include "instrumentation.hpp"
+#include "vtf.hpp"
+#include "helpers/check-bounds.hpp"
+
+namespace VtfParser {
+  using namespace Errors;
+
+  namespace {
+    constexpr std::array<uint8_t, 4> CATALOG_ID = { 'V', 'T', 'F', 'C' };
+
+    uint64_t getPathHash(const CatalogEntry& entry) {
+      return entry.pathHash;
+    }
+
+    uint32_t getOffsetInto(const std::span<const std::byte> data, const std::span<const std::byte> subspan) {
+      if (subspan.empty()) {
+        return 0;
+      }
+
+      return static_cast<uint32_t>(subspan.data() - data.data());
+    }
+  }
+
+  void CatalogBuilder::add(const std::string_view path, const std::span<const std::byte> data) {
+    const Vtf vtf(data);
+    const auto& header = *reinterpret_cast<const HeaderBase*>(data.data());
+    const auto extent = vtf.getHighResImageExtent();
+    const auto lowResExtent = vtf.getLowResImageExtent();
+    const auto highResImageData = vtf.getHighResImageData();
+    const auto lowResImageData = vtf.getLowResImageData();
+
+    entries.insert_or_assign(
+      std::string(path),
+      CatalogEntry{
+        .pathHash = Catalog::hashPath(path),
+        .pathOffset = 0,
+        .pathLength = static_cast<uint32_t>(path.size()),
+        .version = header.version,
+        .highResImageDataOffset = getOffsetInto(data, highResImageData),
+        .highResImageDataSize = static_cast<uint32_t>(highResImageData.size()),
+        .lowResImageDataOffset = getOffsetInto(data, lowResImageData),
+        .lowResImageDataSize = static_cast<uint32_t>(lowResImageData.size()),
+        .flags = vtf.getFlags(),
+        .highResImageFormat = vtf.getHighResImageFormat(),
+        .lowResImageFormat = vtf.getLowResImageFormat(),
+        .width = extent.width,
+        .height = extent.height,
+        .depth = extent.depth,
+        .frames = vtf.getFrames(),
+        .firstFrame = vtf.getFirstFrame(),
+        .faces = vtf.getFaces(),
+        .mipLevels = vtf.getMipLevels(),
+        .lowResImageWidth = lowResExtent.width,
+        .lowResImageHeight = lowResExtent.height,
+        .reserved = {},
+      }
+    );
+  }
+
+  std::vector<std::byte> CatalogBuilder::build() const {
+    std::vector<CatalogEntry> sortedEntries;
+    sortedEntries.reserve(entries.size());
+
+    uint64_t stringTableSize = 0;
+    for (const auto& [path, entry] : entries) {
+      auto& sortedEntry = sortedEntries.emplace_back(entry);
+      sortedEntry.pathOffset = stringTableSize;
+      stringTableSize += path.size();
+    }
+
+    std::ranges::sort(sortedEntries, {}, getPathHash);
+
+    const uint64_t entriesSize = sortedEntries.size() * sizeof(CatalogEntry);
+    const CatalogHeader header = {
+      .signature = CATALOG_ID,
+      .version = CatalogHeader::VERSION,
+      .entryCount = static_cast<uint32_t>(sortedEntries.size()),
+      .reserved = 0,
+      .stringTableOffset = sizeof(CatalogHeader) + entriesSize,
+      .stringTableSize = stringTableSize,
+    };
+
+    std::vector<std::byte> data(header.stringTableOffset + header.stringTableSize);
+    memcpy(data.data(), &header, sizeof(CatalogHeader));
+    std::ranges::copy(std::as_bytes(std::span(sortedEntries)), data.begin() + sizeof(CatalogHeader));
+
+    auto* stringTable = data.data() + header.stringTableOffset;
+    for (const auto& path : entries | std::views::keys) {
+      memcpy(stringTable, path.data(), path.size());
+      stringTable += path.size();
+    }
+
+    return data;
+  }
+
+  Catalog::Catalog(const std::span<const std::byte> data) {
+    if (reinterpret_cast<uintptr_t>(data.data()) % alignof(CatalogEntry) != 0) {
+      throw InvalidArgument("Catalog data must be 8 byte aligned");
+    }
+
+    checkBounds(0, sizeof(CatalogHeader), data.size(), "Failed to parse catalog header");
+    const auto& header = *reinterpret_cast<const CatalogHeader*>(data.data());
+
+    if (header.signature != CATALOG_ID) {
+      throw InvalidHeader("Catalog header has an invalid file ID");
+    }
+
+    if (header.version != CatalogHeader::VERSION) {
+      throw UnsupportedVersion("Catalog version is not supported");
+    }
+
+    const size_t entriesSize = header.entryCount * sizeof(CatalogEntry);
+    if (data.size() - sizeof(CatalogHeader) < entriesSize) {
+      throw OutOfBoundsAccess("Failed to read catalog entries");
+    }
+    if (header.stringTableOffset > data.size() || data.size() - header.stringTableOffset < header.stringTableSize) {
+      throw OutOfBoundsAccess("Failed to read catalog string table");
+    }
+
+    entries = std::span(
+      reinterpret_cast<const CatalogEntry*>(data.data() + sizeof(CatalogHeader)),
+      header.entryCount
+    );
+    stringTable = data.subspan(header.stringTableOffset, header.stringTableSize);
+  }
+
+  const CatalogEntry* Catalog::find(const std::string_view path) const {
+    const auto hash = hashPath(path);
+
+    auto it = std::ranges::lower_bound(entries, hash, {}, getPathHash);
+    for (; it != entries.end() && it->pathHash == hash; ++it) {
+      if (getPath(*it) == path) {
+        Instrumentation::recordCacheLookup(true);
+        return &*it;
+      }
+    }
+
+    Instrumentation::recordCacheLookup(false);
+    return nullptr;
+  }
+
+  std::span<const CatalogEntry> Catalog::getEntries() const {
+    return entries;
+  }
+
+  std::string_view Catalog::getPath(const CatalogEntry& entry) const {
+    if (entry.pathOffset > stringTable.size() || stringTable.size() - entry.pathOffset < entry.pathLength) {
+      throw OutOfBoundsAccess("Catalog entry path is outside of the string table");
+    }
+
+    return {reinterpret_cast<const char*>(stringTable.data() + entry.pathOffset), entry.pathLength};
+  }
+}
@@ -0,0 +1,87 @@
+#pragma once
+
+#include <cstdint>
+#include <map>
+#include <span>
+#include <string>
+#include <string_view>
+#include <vector>
+#include "file-format-objects/catalog.hpp"
+
+namespace VtfParser {
+  /**
+   * Collects metadata from many VTFs and serialises it into a flat, versioned catalog that Catalog can read without parsing.
+   */
+  class CatalogBuilder {
+  public:
+    /**
+     * Parses the VTF given by the binary data and records its metadata under the given path.
+     * Adding the same path twice replaces the previous entry.
+     * @param path Path (or any other unique key) to look the VTF up by.
+     * @param data Binary data of the VTF.
+     */
+    void add(std::string_view path, std::span<const std::byte> data);
+
+    /**
+     * Serialises all added entries into the catalog format.
+     * @return Binary data of the catalog, suitable for writing to disk.
+     */
+    [[nodiscard]] std::vector<std::byte> build() const;
+
+  private:
+    std::map<std::string, CatalogEntry, std::less<>> entries;
+  };
+
+  /**
+   * Provides lookups into a catalog produced by CatalogBuilder.
+   * Entries are read directly from the data, so the catalog can be memory mapped and queried without parsing.
+   */
+  class Catalog {
+  public:
+    /**
+     * Validates the catalog header and wraps the binary data.
+     * Does not take ownership of the data, which must be 8 byte aligned.
+     * @remark Memory mapped files and heap allocations are always suitably aligned.
+     * @param data
+     */
+    explicit Catalog(std::span<const std::byte> data);
+
+    /**
+     * Hashes a path the same way CatalogBuilder does.
+     * @param path
+     * @return 64-bit FNV-1a hash of the path.
+     */
+    [[nodiscard]] static constexpr uint64_t hashPath(const std::string_view path) {
+      uint64_t hash = 0xcbf29ce484222325;
+      for (const auto character : path) {
+        hash ^= static_cast<uint8_t>(character);
+        hash *= 0x100000001b3;
+      }
+      return hash;
+    }
+
+    /**
+     * Finds the entry recorded for the given path.
+     * @param path
+     * @return Pointer to the entry inside the catalog data, or nullptr if the path is not in the catalog.
+     */
+    [[nodiscard]] const CatalogEntry* find(std::string_view path) const;
+
+    /**
+     * Gets every entry in the catalog, sorted by path hash.
+     * @return View over the entries.
+     */
+    [[nodiscard]] std::span<const CatalogEntry> getEntries() const;
+
+    /**
+     * Gets the path an entry was recorded under.
+     * @param entry Entry belonging to this catalog.
+     * @return View over the path in the catalog's string table.
+     */
+    [[nodiscard]] std::string_view getPath(const CatalogEntry& entry) const;
+
+  private:
+    std::span<const CatalogEntry> entries;
+    std::span<const std::byte> stringTable;
+  };
+}
@@ -0,0 +1,450 @@
+#include "codec.hpp"
+#include <algorithm>
+#include <bit>
+#include <cmath>
+#include <cstring>
+#include "errors.hpp"
+#include "instrumentation.hpp"
+#include "slice-view.hpp"
+
+namespace VtfParser {
+  using namespace Errors;
+
+  namespace {
+    using Pixel = std::array<float, 4>;
+
+    float halfToFloat(const uint16_t half) {
+      const uint32_t sign = static_cast<uint32_t>(half & 0x8000u) << 16u;
+      const uint32_t exponent = (half >> 10u) & 0x1fu;
+      const uint32_t mantissa = half & 0x3ffu;
+
+      if (exponent == 0) {
+        const float value = std::ldexp(static_cast<float>(mantissa), -24);
+        return sign ? -value : value;
+      }
+      if (exponent == 0x1f) {
+        return std::bit_cast<float>(sign | 0x7f800000u | (mantissa << 13u));
+      }
+
+      return std::bit_cast<float>(sign | ((exponent + 112u) << 23u) | (mantissa << 13u));
+    }
+
+    uint16_t floatToHalf(const float value) {
+      const auto bits = std::bit_cast<uint32_t>(value);
+      const auto sign = static_cast<uint16_t>((bits >> 16u) & 0x8000u);
+      const int32_t exponent = static_cast<int32_t>((bits >> 23u) & 0xffu) - 112;
+      uint32_t mantissa = bits & 0x7fffffu;
+
+      if (exponent >= 0x1f) {
+        // Infinity, NaN or too large to represent
+        const bool isNan = exponent == 143 && mantissa != 0;
+        return sign | 0x7c00u | (isNan ? 0x200u : 0u);
+      }
+      if (exponent <= 0) {
+        if (exponent < -10) {
+          return sign;
+        }
+
+        mantissa |= 0x800000u;
+        const auto shift = static_cast<uint32_t>(14 - exponent);
+        const uint32_t rounded = mantissa + (1u << (shift - 1u));
+        return sign | static_cast<uint16_t>(rounded >> shift);
+      }
+
+      const uint32_t rounded = (static_cast<uint32_t>(exponent) << 10u | mantissa >> 13u) + ((mantissa >> 12u) & 1u);
+      return sign | static_cast<uint16_t>(std::min<uint32_t>(rounded, 0x7c00u));
+    }
+
+    uint16_t readUint16(const std::byte* data) {
+      uint16_t value;
+      memcpy(&value, data, sizeof(value));
+      return value;
+    }
+
+    constexpr void storeChannel(Pixel& pixel, const Channel channel, const float value) {
+      switch (channel) {
+        case Channel::RED:
+        case Channel::U:
+          pixel[0] = value;
+          break;
+        case Channel::GREEN:
+        case Channel::V:
+          pixel[1] = value;
+          break;
+        case Channel::BLUE:
+        case Channel::W:
+        case Channel::L:
+          pixel[2] = value;
+          break;
+        case Channel::ALPHA:
+        case Channel::Q:
+          pixel[3] = value;
+          break;
+        case Channel::INTENSITY:
+          pixel[0] = value;
+          pixel[1] = value;
+          pixel[2] = value;
+          break;
+        default:
+          break;
+      }
+    }
+
+    template <ImageFormat Format>
+    Pixel decodePixel(const typename SliceView<Format>::Block& block) {
+      constexpr auto& traits = FORMAT_TRAITS<Format>;
+      const auto* bytes = block.data();
+
+      Pixel pixel = {0.0f, 0.0f, 0.0f, 1.0f};
+      if constexpr (traits.floatingPoint) {
+        for (size_t i = 0; i < traits.channelCount; i++) {
+          storeChannel(pixel, traits.channels[i], halfToFloat(readUint16(bytes + i * 2)));
+        }
+      } else if constexpr (traits.channelBits[0] == 16) {
+        for (size_t i = 0; i < traits.channelCount; i++) {
+          storeChannel(pixel, traits.channels[i], static_cast<float>(readUint16(bytes + i * 2)) / 65535.0f);
+        }
+      } else if constexpr (traits.channelBits[0] == 8) {
+        for (size_t i = 0; i < traits.channelCount; i++) {
+          storeChannel(pixel, traits.channels[i], static_cast<float>(std::to_integer<uint8_t>(bytes[i])) / 255.0f);
+        }
+      } else {
+        // Packed formats store the first channel in the least significant bits
+        uint32_t packed = readUint16(bytes);
+        for (size_t i = 0; i < traits.channelCount; i++) {
+          const uint32_t maxValue = (1u << traits.channelBits[i]) - 1u;
+          storeChannel(pixel, traits.channels[i], static_cast<float>(packed & maxValue) / static_cast<float>(maxValue));
+          packed >>= traits.channelBits[i];
+        }
+      }
+
+      if constexpr (Format == ImageFormat::RGB888_BLUESCREEN || Format == ImageFormat::BGR888_BLUESCREEN) {
+        if (pixel[0] == 0.0f && pixel[1] == 0.0f && pixel[2] == 1.0f) {
+          pixel = {0.0f, 0.0f, 0.0f, 0.0f};
+        }
+      }
+
+      return pixel;
+    }
+
+    Pixel decodeRgb565(const uint16_t colour) {
+      return {
+        static_cast<float>((colour >> 11u) & 0x1fu) / 31.0f,
+        static_cast<float>((colour >> 5u) & 0x3fu) / 63.0f,
+        static_cast<float>(colour & 0x1fu) / 31.0f,
+        1.0f,
+      };
+    }
+
+    /**
+     * Decodes the colour half of a DXT block.
+     * @param block 8 bytes of colour data.
+     * @param allowTransparent Whether the block may use 1-bit alpha (DXT1 only).
+     * @param texels Output pixels in row-major order.
+     */
+    void decodeColourBlock(const std::byte* block, const bool allowTransparent, std::array<Pixel, 16>& texels) {
+      const auto colour0 = readUint16(block);
+      const auto colour1 = readUint16(block + 2);
+
+      std::array<Pixel, 4> palette = {decodeRgb565(colour0), decodeRgb565(colour1)};
+      if (colour0 > colour1 || !allowTransparent) {
+        for (size_t channel = 0; channel < 3; channel++) {
+          palette[2][channel] = (2.0f * palette[0][channel] + palette[1][channel]) / 3.0f;
+          palette[3][channel] = (palette[0][channel] + 2.0f * palette[1][channel]) / 3.0f;
+        }
+        palette[2][3] = 1.0f;
+        palette[3][3] = 1.0f;
+      } else {
+        for (size_t channel = 0; channel < 3; channel++) {
+          palette[2][channel] = (palette[0][channel] + palette[1][channel]) / 2.0f;
+        }
+        palette[2][3] = 1.0f;
+        palette[3] = {0.0f, 0.0f, 0.0f, 0.0f};
+      }
+
+      uint32_t indices;
+      memcpy(&indices, block + 4, sizeof(indices));
+      for (auto& texel : texels) {
+        texel = palette[indices & 0x3u];
+        indices >>= 2u;
+      }
+    }
+
+    void decodeExplicitAlphaBlock(const std::byte* block, std::array<Pixel, 16>& texels) {
+      uint64_t alphas;
+      memcpy(&alphas, block, sizeof(alphas));
+      for (auto& texel : texels) {
+        texel[3] = static_cast<float>(alphas & 0xfu) / 15.0f;
+        alphas >>= 4u;
+      }
+    }
+
+    void decodeInterpolatedAlphaBlock(const std::byte* block, std::array<Pixel, 16>& texels) {
+      const auto alpha0 = static_cast<float>(std::to_integer<uint8_t>(block[0])) / 255.0f;
+      const auto alpha1 = static_cast<float>(std::to_integer<uint8_t>(block[1])) / 255.0f;
+
+      std::array<float, 8> palette = {alpha0, alpha1};
+      if (block[0] > block[1]) {
+        for (size_t i = 1; i < 7; i++) {
+          palette[i + 1] = (static_cast<float>(7 - i) * alpha0 + static_cast<float>(i) * alpha1) / 7.0f;
+        }
+      } else {
+        for (size_t i = 1; i < 5; i++) {
+          palette[i + 1] = (static_cast<float>(5 - i) * alpha0 + static_cast<float>(i) * alpha1) / 5.0f;
+        }
+        palette[6] = 0.0f;
+        palette[7] = 1.0f;
+      }
+
+      uint64_t indices = 0;
+      memcpy(&indices, block + 2, 6);
+      for (auto& texel : texels) {
+        texel[3] = palette[indices & 0x7u];
+        indices >>= 3u;
+      }
+    }
+
+    template <ImageFormat Format>
+    void decodeInto(const SliceView<Format>& view, float* pixels) {
+      const auto width = view.getWidth();
+      const auto height = view.getHeight();
+
+      if constexpr (SliceView<Format>::TRAITS.compressed) {
+        std::array<Pixel, 16> texels;
+        for (size_t blockY = 0; blockY < view.getBlocksHigh(); blockY++) {
+          for (size_t blockX = 0; blockX < view.getBlocksWide(); blockX++) {
+            const auto* block = view.getBlock(blockX, blockY).data();
+
+            if constexpr (Format == ImageFormat::DXT1 || Format == ImageFormat::DXT1_ONEBITALPHA) {
+              decodeColourBlock(block, true, texels);
+            } else if constexpr (Format == ImageFormat::DXT3) {
+              decodeColourBlock(block + 8, false, texels);
+              decodeExplicitAlphaBlock(block, texels);
+            } else {
+              decodeColourBlock(block + 8, false, texels);
+              decodeInterpolatedAlphaBlock(block, texels);
+            }
+
+            const auto texelsWide = std::min<size_t>(4, width - blockX * 4);
+            const auto texelsHigh = std::min<size_t>(4, height - blockY * 4);
+            for (size_t y = 0; y < texelsHigh; y++) {
+              auto* row = pixels + ((blockY * 4 + y) * width + blockX * 4) * 4;
+              memcpy(row, texels[y * 4].data(), texelsWide * sizeof(Pixel));
+            }
+          }
+        }
+      } else if constexpr (Format == ImageFormat::P8) {
+        throw UnsupportedImageFormat("Paletted images cannot be decoded");
+      } else {
+        for (const auto& block : view.getBlocks()) {
+          const auto pixel = decodePixel<Format>(block);
+          memcpy(pixels, pixel.data(), sizeof(Pixel));
+          pixels += 4;
+        }
+      }
+    }
+
+    /**
+     * Integer-only DXT1 decoder, avoiding the float conversions of the generic path.
+     */
+    void decodeDxt1Rgba8(const SliceView<ImageFormat::DXT1>& view, uint8_t* pixels) {
+      using Texel = std::array<uint8_t, 4>;
+
+      const auto expand565 = [](const uint16_t colour) -> Texel {
+        const uint32_t red = (colour >> 11u) & 0x1fu;
+        const uint32_t green = (colour >> 5u) & 0x3fu;
+        const uint32_t blue = colour & 0x1fu;
+        return {
+          static_cast<uint8_t>((red << 3u) | (red >> 2u)),
+          static_cast<uint8_t>((green << 2u) | (green >> 4u)),
+          static_cast<uint8_t>((blue << 3u) | (blue >> 2u)),
+          255,
+        };
+      };
+
+      const auto width = view.getWidth();
+      const auto height = view.getHeight();
+
+      for (size_t blockY = 0; blockY < view.getBlocksHigh(); blockY++) {
+        for (size_t blockX = 0; blockX < view.getBlocksWide(); blockX++) {
+          const auto* block = view.getBlock(blockX, blockY).data();
+          const auto colour0 = readUint16(block);
+          const auto colour1 = readUint16(block + 2);
+
+          std::array<Texel, 4> palette = {expand565(colour0), expand565(colour1)};
+          for (size_t channel = 0; channel < 3; channel++) {
+            const uint32_t value0 = palette[0][channel];
+            const uint32_t value1 = palette[1][channel];
+            if (colour0 > colour1) {
+              palette[2][channel] = static_cast<uint8_t>((2 * value0 + value1) / 3);
+              palette[3][channel] = static_cast<uint8_t>((value0 + 2 * value1) / 3);
+            } else {
+              palette[2][channel] = static_cast<uint8_t>((value0 + value1) / 2);
+              palette[3][channel] = 0;
+            }
+          }
+          palette[2][3] = 255;
+          palette[3][3] = colour0 > colour1 ? 255 : 0;
+
+          uint32_t indices;
+          memcpy(&indices, block + 4, sizeof(indices));
+
+          const auto texelsWide = std::min<size_t>(4, width - blockX * 4);
+          const auto texelsHigh = std::min<size_t>(4, height - blockY * 4);
+          for (size_t y = 0; y < 4; y++) {
+            for (size_t x = 0; x < 4; x++, indices >>= 2u) {
+              if (x < texelsWide && y < texelsHigh) {
+                memcpy(pixels + ((blockY * 4 + y) * width + blockX * 4 + x) * 4, palette[indices & 0x3u].data(), 4);
+              }
+            }
+          }
+        }
+      }
+    }
+
+    uint8_t toUnorm8(const float value) {
+      // Written so NaN maps to 0, as casting it to an integer is undefined
+      return static_cast<uint8_t>((value > 0.0f ? std::min(value, 1.0f) : 0.0f) * 255.0f + 0.5f);
+    }
+
+    template <ImageFormat Format>
+    void encodeInto(const RgbaImage& image, std::byte* data) {
+      constexpr auto& traits = FORMAT_TRAITS<Format>;
+
+      for (size_t i = 0; i < image.width * image.height; i++) {
+        const auto* pixel = image.pixels.data() + i * 4;
+
+        for (size_t channel = 0; channel < traits.channelCount; channel++) {
+          float value = 0.0f;
+          switch (traits.channels[channel]) {
+            case Channel::RED:
+            case Channel::INTENSITY:
+              value = pixel[0];
+              break;
+            case Channel::GREEN:
+              value = pixel[1];
+              break;
+            case Channel::BLUE:
+              value = pixel[2];
+              break;
+            case Channel::ALPHA:
+              value = pixel[3];
+              break;
+            default:
+              break;
+          }
+
+          if constexpr (traits.floatingPoint) {
+            const auto half = floatToHalf(value);
+            memcpy(data + channel * 2, &half, sizeof(half));
+          } else {
+            data[channel] = static_cast<std::byte>(toUnorm8(value));
+          }
+        }
+
+        data += traits.bytesPerBlock;
+      }
+    }
+  }
+
+  RgbaImage decodeSlice(
+    const ImageFormat format,
+    const std::span<const std::byte> data,
+    const size_t width,
+    const size_t height
+  ) {
+    const Instrumentation::ScopedTimer timer;
+
+    RgbaImage image = {.width = width, .height = height, .pixels = {}};
+    image.pixels.resize(width * height * 4);
+
+    visitSlice(format, data, width, height, [&image](const auto& view) { decodeInto(view, image.pixels.data()); });
+
+    Instrumentation::recordFormatThroughput(
+      format,
+      getSliceSizeBytes(getFormatTraits(format), width, height),
+      timer.getElapsedNanoseconds()
+    );
+    return image;
+  }
+
+  Rgba8Image decodeSliceRgba8(
+    const ImageFormat format,
+    const std::span<const std::byte> data,
+    const size_t width,
+    const size_t height
+  ) {
+    if (format != ImageFormat::DXT1 && format != ImageFormat::DXT1_ONEBITALPHA) {
+      const auto decoded = decodeSlice(format, data, width, height);
+
+      Rgba8Image image = {.width = width, .height = height, .pixels = {}};
+      image.pixels.resize(decoded.pixels.size());
+      std::ranges::transform(decoded.pixels, image.pixels.begin(), toUnorm8);
+      return image;
+    }
+
+    const Instrumentation::ScopedTimer timer;
+
+    Rgba8Image image = {.width = width, .height = height, .pixels = {}};
+    image.pixels.resize(width * height * 4);
+    decodeDxt1Rgba8(SliceView<ImageFormat::DXT1>(data, width, height), image.pixels.data());
+
+    Instrumentation::recordFormatThroughput(
+      format,
+      getSliceSizeBytes(FORMAT_TRAITS<ImageFormat::DXT1>, width, height),
+      timer.getElapsedNanoseconds()
+    );
+    return image;
+  }
+
+  bool canEncode(const ImageFormat format) {
+    switch (format) {
+      case ImageFormat::RGBA8888:
+      case ImageFormat::BGRA8888:
+      case ImageFormat::ABGR8888:
+      case ImageFormat::ARGB8888:
+      case ImageFormat::RGB888:
+      case ImageFormat::BGR888:
+      case ImageFormat::I8:
+      case ImageFormat::A8:
+      case ImageFormat::RGBA16161616F:
+        return true;
+      default:
+        return false;
+    }
+  }
+
+  std::vector<std::byte> encodeSlice(const ImageFormat format, const RgbaImage& image) {
+    const Instrumentation::ScopedTimer timer;
+
+    if (!canEncode(format)) {
+      throw UnsupportedImageFormat("Image format cannot be encoded");
+    }
+
+    std::vector<std::byte> data(getSliceSizeBytes(getFormatTraits(format), image.width, image.height));
+
+#define ENCODE_FORMAT(format) \
+  case ImageFormat::format: \
+    encodeInto<ImageFormat::format>(image, data.data()); \
+    break;
+
+    switch (format) {
+      ENCODE_FORMAT(RGBA8888)
+      ENCODE_FORMAT(BGRA8888)
+      ENCODE_FORMAT(ABGR8888)
+      ENCODE_FORMAT(ARGB8888)
+      ENCODE_FORMAT(RGB888)
+      ENCODE_FORMAT(BGR888)
+      ENCODE_FORMAT(I8)
+      ENCODE_FORMAT(A8)
+      ENCODE_FORMAT(RGBA16161616F)
+      default:
+        break;
+    }
+
+#undef ENCODE_FORMAT
+
+    Instrumentation::recordFormatThroughput(format, data.size(), timer.getElapsedNanoseconds());
+    return data;
+  }
+}
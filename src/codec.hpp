@@ -0,0 +1,92 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <vector>
+#include "file-format-objects/enums.hpp"
+
+namespace VtfParser {
+  /**
+   * Uncompressed image with four 32-bit float channels (RGBA) per pixel, stored row by row.
+   */
+  struct RgbaImage {
+    /**
+     * Width of the image in pixels.
+     */
+    size_t width;
+    /**
+     * Height of the image in pixels.
+     */
+    size_t height;
+    /**
+     * Interleaved RGBA channels, width * height * 4 floats.
+     * @remark Unsigned normalised formats decode to [0, 1]. Floating point formats are left unscaled.
+     */
+    std::vector<float> pixels;
+  };
+
+  /**
+   * Uncompressed image with four 8-bit unsigned normalised channels (RGBA) per pixel, stored row by row.
+   */
+  struct Rgba8Image {
+    /**
+     * Width of the image in pixels.
+     */
+    size_t width;
+    /**
+     * Height of the image in pixels.
+     */
+    size_t height;
+    /**
+     * Interleaved RGBA channels, width * height * 4 bytes.
+     */
+    std::vector<uint8_t> pixels;
+  };
+
+  /**
+   * Decodes a single 2D image slice into RGBA floats.
+   * @remark Channels missing from the format are filled with zero, except alpha which is filled with one.
+   * @remark Intensity formats are copied to red, green and blue. UV formats are stored in red, green, blue and alpha.
+   * @param format Format of the slice.
+   * @param data Slice data, e.g. from Vtf::getImageSliceData().
+   * @param width Width of the slice in pixels.
+   * @param height Height of the slice in pixels.
+   * @return Decoded image.
+   * @throws Errors::UnsupportedImageFormat if the format cannot be decoded (P8).
+   */
+  [[nodiscard]] RgbaImage decodeSlice(ImageFormat format, std::span<const std::byte> data, size_t width, size_t height);
+
+  /**
+   * Decodes a single 2D image slice into 8-bit RGBA, clamping values outside of [0, 1].
+   * @remark DXT1 is decoded directly to integers, making this the fastest way to decode low res images.
+   * @param format Format of the slice.
+   * @param data Slice data.
+   * @param width Width of the slice in pixels.
+   * @param height Height of the slice in pixels.
+   * @return Decoded image.
+   * @throws Errors::UnsupportedImageFormat if the format cannot be decoded (P8).
+   */
+  [[nodiscard]] Rgba8Image decodeSliceRgba8(
+    ImageFormat format,
+    std::span<const std::byte> data,
+    size_t width,
+    size_t height
+  );
+
+  /**
+   * Checks whether encodeSlice() can write the given format.
+   * @param format
+   * @return True for RGBA8888, BGRA8888, ABGR8888, ARGB8888, RGB888, BGR888, I8, A8 and RGBA16161616F.
+   */
+  [[nodiscard]] bool canEncode(ImageFormat format);
+
+  /**
+   * Encodes an RGBA float image into the given uncompressed format.
+   * @param format Format to encode to. Must satisfy canEncode().
+   * @param image Image to encode.
+   * @return Encoded slice data.
+   * @throws Errors::UnsupportedImageFormat if the format cannot be encoded.
+   */
+  [[nodiscard]] std::vector<std::byte> encodeSlice(ImageFormat format, const RgbaImage& image);
+}
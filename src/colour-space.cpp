@@ -0,0 +1,204 @@
+#include "colour-space.hpp"
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include "errors.hpp"
+
+namespace VtfParser {
+  using namespace Errors;
+
+  namespace {
+    /**
+     * Resolution of the linear to sRGB table. Fine enough that the result matches the exact transfer function
+     * to within one step, including in the steep region near black.
+     */
+    constexpr size_t LINEAR_TO_SRGB_TABLE_SIZE = 16384;
+
+    float applySrgbTransfer(const float value) {
+      return value <= 0.0031308f ? value * 12.92f : 1.055f * std::pow(value, 1.0f / 2.4f) - 0.055f;
+    }
+
+    const std::array<float, 256>& getSrgbToLinearTable() {
+      static const auto table = [] {
+        std::array<float, 256> values{};
+        for (size_t i = 0; i < values.size(); i++) {
+          const auto value = static_cast<float>(i) / 255.0f;
+          values[i] = value <= 0.04045f ? value / 12.92f : std::pow((value + 0.055f) / 1.055f, 2.4f);
+        }
+        return values;
+      }();
+
+      return table;
+    }
+
+    const std::array<uint8_t, LINEAR_TO_SRGB_TABLE_SIZE>& getLinearToSrgbTable() {
+      static const auto table = [] {
+        std::array<uint8_t, LINEAR_TO_SRGB_TABLE_SIZE> values{};
+        for (size_t i = 0; i < values.size(); i++) {
+          const auto value = static_cast<float>(i) / static_cast<float>(LINEAR_TO_SRGB_TABLE_SIZE - 1);
+          values[i] = static_cast<uint8_t>(std::clamp(applySrgbTransfer(value), 0.0f, 1.0f) * 255.0f + 0.5f);
+        }
+        return values;
+      }();
+
+      return table;
+    }
+
+    /**
+     * Samples of the transfer function at the same points as getLinearToSrgbTable(), for interpolation.
+     * The curve is smooth enough between samples that the interpolation error stays below 1e-5.
+     */
+    const std::array<float, LINEAR_TO_SRGB_TABLE_SIZE>& getLinearToSrgbFloatTable() {
+      static const auto table = [] {
+        std::array<float, LINEAR_TO_SRGB_TABLE_SIZE> values{};
+        for (size_t i = 0; i < values.size(); i++) {
+          values[i] = applySrgbTransfer(static_cast<float>(i) / static_cast<float>(LINEAR_TO_SRGB_TABLE_SIZE - 1));
+        }
+        return values;
+      }();
+
+      return table;
+    }
+
+    /**
+     * Clamps to [0, 1], mapping NaN to 0 so the result can always be scaled and cast to an integer.
+     */
+    float clampToUnit(const float value) {
+      return !(value > 0.0f) ? 0.0f : std::min(value, 1.0f);
+    }
+
+    size_t getLinearToSrgbIndex(const float value) {
+      constexpr auto scale = static_cast<float>(LINEAR_TO_SRGB_TABLE_SIZE - 1);
+      return static_cast<size_t>(clampToUnit(value) * scale + 0.5f);
+    }
+
+    void checkRegion(const ImageRegion& region, const size_t width, const size_t height) {
+      const bool fitsHorizontally = region.x <= width && width - region.x >= region.width;
+      const bool fitsVertically = region.y <= height && height - region.y >= region.height;
+      if (!fitsHorizontally || !fitsVertically) {
+        throw OutOfBoundsAccess("Region is outside of the image");
+      }
+    }
+  }
+
+  ColourSpace getColourSpace(const TextureFlags flags) {
+    const auto srgbFlags = TextureFlags::SRGB | TextureFlags::PRE_SRGB;
+    return (flags & srgbFlags) != TextureFlags::NONE ? ColourSpace::SRGB : ColourSpace::LINEAR;
+  }
+
+  float srgbToLinear(const uint8_t value) {
+    return getSrgbToLinearTable()[value];
+  }
+
+  uint8_t linearToSrgb(const float value) {
+    return getLinearToSrgbTable()[getLinearToSrgbIndex(value)];
+  }
+
+  RgbaImage toLinear(const Rgba8Image& image, const ColourSpace colourSpace) {
+    return toLinear(image, colourSpace, {.x = 0, .y = 0, .width = image.width, .height = image.height});
+  }
+
+  RgbaImage toLinear(const Rgba8Image& image, const ColourSpace colourSpace, const ImageRegion& region) {
+    checkRegion(region, image.width, image.height);
+
+    RgbaImage linear = {.width = region.width, .height = region.height, .pixels = {}};
+    linear.pixels.resize(region.width * region.height * 4);
+
+    // Linear 8-bit data goes through a table too, which avoids a division per channel
+    std::array<float, 256> unormTable{};
+    for (size_t i = 0; i < unormTable.size(); i++) {
+      unormTable[i] = static_cast<float>(i) / 255.0f;
+    }
+    const auto& colourTable = colourSpace == ColourSpace::SRGB ? getSrgbToLinearTable() : unormTable;
+
+    for (size_t y = 0; y < region.height; y++) {
+      const auto* source = image.pixels.data() + ((region.y + y) * image.width + region.x) * 4;
+      auto* target = linear.pixels.data() + y * region.width * 4;
+
+      for (size_t i = 0; i < region.width * 4; i += 4) {
+        target[i] = colourTable[source[i]];
+        target[i + 1] = colourTable[source[i + 1]];
+        target[i + 2] = colourTable[source[i + 2]];
+        target[i + 3] = unormTable[source[i + 3]];
+      }
+    }
+
+    return linear;
+  }
+
+  Rgba8Image fromLinear(const RgbaImage& image, const ColourSpace colourSpace) {
+    return fromLinear(image, colourSpace, {.x = 0, .y = 0, .width = image.width, .height = image.height});
+  }
+
+  Rgba8Image fromLinear(const RgbaImage& image, const ColourSpace colourSpace, const ImageRegion& region) {
+    checkRegion(region, image.width, image.height);
+
+    Rgba8Image converted = {.width = region.width, .height = region.height, .pixels = {}};
+    converted.pixels.resize(region.width * region.height * 4);
+
+    const auto toUnorm8 = [](const float value) {
+      return static_cast<uint8_t>(clampToUnit(value) * 255.0f + 0.5f);
+    };
+    const auto& srgbTable = getLinearToSrgbTable();
+
+    for (size_t y = 0; y < region.height; y++) {
+      const auto* source = image.pixels.data() + ((region.y + y) * image.width + region.x) * 4;
+      auto* target = converted.pixels.data() + y * region.width * 4;
+
+      if (colourSpace == ColourSpace::SRGB) {
+        for (size_t i = 0; i < region.width * 4; i += 4) {
+          target[i] = srgbTable[getLinearToSrgbIndex(source[i])];
+          target[i + 1] = srgbTable[getLinearToSrgbIndex(source[i + 1])];
+          target[i + 2] = srgbTable[getLinearToSrgbIndex(source[i + 2])];
+          target[i + 3] = toUnorm8(source[i + 3]);
+        }
+      } else {
+        std::transform(source, source + region.width * 4, target, toUnorm8);
+      }
+    }
+
+    return converted;
+  }
+
+  RgbaImage toSrgb(const RgbaImage& image) {
+    RgbaImage converted = {.width = image.width, .height = image.height, .pixels = {}};
+    converted.pixels.resize(image.pixels.size());
+
+    const auto& table = getLinearToSrgbFloatTable();
+    const auto convert = [&table](const float value) {
+      constexpr auto scale = static_cast<float>(LINEAR_TO_SRGB_TABLE_SIZE - 1);
+      const auto position = clampToUnit(value) * scale;
+      const auto index = std::min(static_cast<size_t>(position), LINEAR_TO_SRGB_TABLE_SIZE - 2);
+      const auto fraction = position - static_cast<float>(index);
+      return table[index] + (table[index + 1] - table[index]) * fraction;
+    };
+
+    for (size_t i = 0; i < image.pixels.size(); i += 4) {
+      converted.pixels[i] = convert(image.pixels[i]);
+      converted.pixels[i + 1] = convert(image.pixels[i + 1]);
+      converted.pixels[i + 2] = convert(image.pixels[i + 2]);
+      converted.pixels[i + 3] = image.pixels[i + 3];
+    }
+
+    return converted;
+  }
+
+  RgbaImage decodeSliceLinear(
+    const Vtf& vtf,
+    const uint8_t mipLevel,
+    const uint16_t frame,
+    const uint8_t face,
+    const uint16_t depth
+  ) {
+    const auto format = vtf.getHighResImageFormat();
+    const auto extent = vtf.getHighResImageExtent(mipLevel);
+    const auto data = vtf.getImageSliceData(mipLevel, frame, face, depth);
+
+    // High dynamic range formats are always stored linear
+    if (getColourSpace(vtf.getFlags()) == ColourSpace::LINEAR || isHighDynamicRange(getFormatTraits(format))) {
+      return decodeSlice(format, data, extent.width, extent.height);
+    }
+
+    return toLinear(decodeSliceRgba8(format, data, extent.width, extent.height), ColourSpace::SRGB);
+  }
+}
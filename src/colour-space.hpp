@@ -0,0 +1,118 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include "codec.hpp"
+#include "vtf.hpp"
+
+namespace VtfParser {
+  /**
+   * Encoding of a texture's colour channels.
+   */
+  enum class ColourSpace : uint8_t {
+    /**
+     * Channels are proportional to light intensity.
+     */
+    LINEAR,
+    /**
+     * Channels use the sRGB transfer function (gamma encoded).
+     */
+    SRGB,
+  };
+
+  /**
+   * Rectangle within an image, in pixels.
+   */
+  struct ImageRegion {
+    size_t x;
+    size_t y;
+    size_t width;
+    size_t height;
+  };
+
+  /**
+   * Gets the colour space a texture's data is stored in.
+   * @remark TextureFlags::SRGB and TextureFlags::PRE_SRGB are both treated as meaning the data is gamma encoded.
+   * @param flags Flags of the texture.
+   * @return SRGB if either flag is set, otherwise LINEAR.
+   */
+  [[nodiscard]] ColourSpace getColourSpace(TextureFlags flags);
+
+  /**
+   * Converts a single 8-bit sRGB channel to linear using a lookup table.
+   * @param value
+   * @return Linear value in [0, 1].
+   */
+  [[nodiscard]] float srgbToLinear(uint8_t value);
+
+  /**
+   * Converts a single linear channel to 8-bit sRGB using a lookup table.
+   * @param value Linear value. Clamped to [0, 1], with NaN treated as 0.
+   * @return sRGB value.
+   */
+  [[nodiscard]] uint8_t linearToSrgb(float value);
+
+  /**
+   * Converts an 8-bit image to linear floats.
+   * @remark Alpha is never gamma encoded, so it is only rescaled.
+   * @param image Image to convert.
+   * @param colourSpace Colour space of the image.
+   * @return Linear image.
+   */
+  [[nodiscard]] RgbaImage toLinear(const Rgba8Image& image, ColourSpace colourSpace);
+
+  /**
+   * Converts a region of an 8-bit image to linear floats.
+   * @param image Image to convert.
+   * @param colourSpace Colour space of the image.
+   * @param region Region of the image to convert.
+   * @return Linear image the size of the region.
+   * @throws Errors::OutOfBoundsAccess if the region is not within the image.
+   */
+  [[nodiscard]] RgbaImage toLinear(const Rgba8Image& image, ColourSpace colourSpace, const ImageRegion& region);
+
+  /**
+   * Converts a linear float image to 8-bit in the given colour space.
+   * @remark Channels are clamped to [0, 1], with NaN treated as 0.
+   * @param image Image to convert.
+   * @param colourSpace Colour space to convert to.
+   * @return 8-bit image.
+   */
+  [[nodiscard]] Rgba8Image fromLinear(const RgbaImage& image, ColourSpace colourSpace);
+
+  /**
+   * Converts a region of a linear float image to 8-bit in the given colour space.
+   * @param image Image to convert.
+   * @param colourSpace Colour space to convert to.
+   * @param region Region of the image to convert.
+   * @return 8-bit image the size of the region.
+   * @throws Errors::OutOfBoundsAccess if the region is not within the image.
+   */
+  [[nodiscard]] Rgba8Image fromLinear(const RgbaImage& image, ColourSpace colourSpace, const ImageRegion& region);
+
+  /**
+   * Gamma encodes a linear float image to sRGB, keeping float precision.
+   * @remark Use this rather than fromLinear() when writing formats deeper than 8 bits, e.g. RGBA16161616F.
+   * @remark Alpha is copied unchanged. Colour channels are clamped to [0, 1], with NaN treated as 0.
+   * @param image Linear image.
+   * @return sRGB image with channels in [0, 1].
+   */
+  [[nodiscard]] RgbaImage toSrgb(const RgbaImage& image);
+
+  /**
+   * Decodes an image slice of a VTF into linear floats, converting from sRGB when the texture's flags call for it.
+   * @param vtf
+   * @param mipLevel Level of the mipmap chain.
+   * @param frame Frame of animation.
+   * @param face Face of a cubemap.
+   * @param depth Depth or Z value of a volumetric texture.
+   * @return Linear image.
+   */
+  [[nodiscard]] RgbaImage decodeSliceLinear(
+    const Vtf& vtf,
+    uint8_t mipLevel = 0,
+    uint16_t frame = 0,
+    uint8_t face = 0,
+    uint16_t depth = 0
+  );
+}
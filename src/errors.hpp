@@ -1,5 +1,6 @@
 #pragma once
 
+#include <cstddef>
 #include <cstdint>
 #include <stdexcept>
 
@@ -14,13 +15,36 @@ namespace VtfParser::Errors {
     InvalidHeader,
     UnsupportedVersion,
     OutOfBoundsAccess,
+    UnsupportedImageFormat,
+    InvalidArgument,
   };
 
+  /**
+   * Number of values in the Reason enum.
+   */
+  constexpr size_t REASON_COUNT = static_cast<size_t>(Reason::InvalidArgument) + 1;
+}
+
+#ifdef VTFPARSER_INSTRUMENTATION
+namespace VtfParser::Instrumentation {
+  // Declared here rather than included, as instrumentation.hpp depends on this header
+  void recordError(Errors::Reason reason);
+}
+#endif
+
+namespace VtfParser::Errors {
   class Error : public std::runtime_error {
   public:
-    Error(Reason reason, const char* message) : reason(reason), std::runtime_error(message) {}
+    /**
+     * @remark Every error is counted by Instrumentation when it is compiled in, wherever it is thrown from.
+     */
+    Error(Reason reason, const char* message) : reason(reason), std::runtime_error(message) {
+#ifdef VTFPARSER_INSTRUMENTATION
+      Instrumentation::recordError(reason);
+#endif
+    }
 
-    Reason getReason() {
+    [[nodiscard]] Reason getReason() const {
       return reason;
     }
 
@@ -31,6 +55,8 @@ namespace VtfParser::Errors {
   ERROR_FOR_REASON(InvalidHeader);
   ERROR_FOR_REASON(UnsupportedVersion);
   ERROR_FOR_REASON(OutOfBoundsAccess);
+  ERROR_FOR_REASON(UnsupportedImageFormat);
+  ERROR_FOR_REASON(InvalidArgument);
 }
 
 #undef ERROR_FOR_REASON
@@ -0,0 +1,138 @@
+#pragma once
+
+#include "enums.hpp"
+#include <array>
+#include <cstdint>
+
+namespace VtfParser {
+  /**
+   * Header of a metadata catalog produced by CatalogBuilder.
+   * @remark Immediately followed by CatalogHeader::entryCount CatalogEntry structs, sorted by path hash.
+   * @remark Every field is naturally aligned, so a catalog mapped at an 8 byte aligned address can be read in place.
+   */
+  struct CatalogHeader {
+    static constexpr uint32_t VERSION = 1;
+
+    /**
+     * File signature ("VTFC").
+     */
+    std::array<uint8_t, 4> signature;
+    /**
+     * Catalog format version.
+     */
+    uint32_t version;
+    /**
+     * Number of entries in the catalog.
+     */
+    uint32_t entryCount;
+    /**
+     * Reserved (8 byte alignment).
+     */
+    uint32_t reserved;
+    /**
+     * Offset from the start of the catalog to the path string table.
+     */
+    uint64_t stringTableOffset;
+    /**
+     * Size of the path string table in bytes.
+     */
+    uint64_t stringTableSize;
+  };
+
+  static_assert(sizeof(CatalogHeader) == 32);
+  static_assert(alignof(CatalogHeader) == 8);
+
+  /**
+   * Metadata recorded for a single VTF in a catalog.
+   * @remark Fields are ordered largest first so that none need padding.
+   */
+  struct CatalogEntry {
+    /**
+     * FNV-1a hash of the path the VTF was added under. Entries are sorted by this value.
+     */
+    uint64_t pathHash;
+    /**
+     * Offset of the path into the string table.
+     */
+    uint64_t pathOffset;
+    /**
+     * Length of the path in bytes (not null terminated).
+     */
+    uint32_t pathLength;
+    /**
+     * File format version of the VTF. Index zero is MAJOR and one is MINOR.
+     */
+    std::array<uint32_t, 2> version;
+    /**
+     * Offset of the high resolution image data in the VTF.
+     */
+    uint32_t highResImageDataOffset;
+    /**
+     * Size of the high resolution image data in bytes.
+     */
+    uint32_t highResImageDataSize;
+    /**
+     * Offset of the low resolution image data in the VTF.
+     */
+    uint32_t lowResImageDataOffset;
+    /**
+     * Size of the low resolution image data in bytes.
+     */
+    uint32_t lowResImageDataSize;
+    /**
+     * VTF flags.
+     */
+    TextureFlags flags;
+    /**
+     * Format of the high resolution image.
+     */
+    ImageFormat highResImageFormat;
+    /**
+     * Format of the low resolution image.
+     */
+    ImageFormat lowResImageFormat;
+    /**
+     * Width of the largest mipmap in pixels.
+     */
+    uint16_t width;
+    /**
+     * Height of the largest mipmap in pixels.
+     */
+    uint16_t height;
+    /**
+     * Depth of the largest mipmap in pixels.
+     */
+    uint16_t depth;
+    /**
+     * Number of frames of animation.
+     */
+    uint16_t frames;
+    /**
+     * First frame in animation.
+     */
+    uint16_t firstFrame;
+    /**
+     * Number of cubemap faces.
+     */
+    uint8_t faces;
+    /**
+     * Number of MIP levels.
+     */
+    uint8_t mipLevels;
+    /**
+     * Low resolution image width.
+     */
+    uint8_t lowResImageWidth;
+    /**
+     * Low resolution image height.
+     */
+    uint8_t lowResImageHeight;
+    /**
+     * Reserved (8 byte alignment).
+     */
+    std::array<uint8_t, 2> reserved;
+  };
+
+  static_assert(sizeof(CatalogEntry) == 72);
+  static_assert(alignof(CatalogEntry) == 8);
+}
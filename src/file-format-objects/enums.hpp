@@ -178,9 +178,9 @@ namespace VtfParser {
     UNUSED_80000000 = 0x80000000
   };
   inline TextureFlags operator&(const TextureFlags& a, const TextureFlags& b) {
-    return static_cast<TextureFlags>(static_cast<uint8_t>(a) & static_cast<uint8_t>(b));
+    return static_cast<TextureFlags>(static_cast<uint32_t>(a) & static_cast<uint32_t>(b));
   }
   inline TextureFlags operator|(const TextureFlags& a, const TextureFlags& b) {
-    return static_cast<TextureFlags>(static_cast<uint8_t>(a) & static_cast<uint8_t>(b));
+    return static_cast<TextureFlags>(static_cast<uint32_t>(a) | static_cast<uint32_t>(b));
   }
 }
@@ -0,0 +1,227 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <string_view>
+#include "errors.hpp"
+#include "file-format-objects/enums.hpp"
+
+namespace VtfParser {
+  /**
+   * Number of ImageFormat values, including NONE.
+   */
+  constexpr size_t IMAGE_FORMAT_COUNT = static_cast<size_t>(ImageFormat::UVLX8888) + 2;
+
+  /**
+   * Meaning of a single channel in a pixel.
+   */
+  enum class Channel : uint8_t {
+    NONE,
+    RED,
+    GREEN,
+    BLUE,
+    ALPHA,
+    /**
+     * Greyscale intensity.
+     */
+    INTENSITY,
+    /**
+     * Index into a palette.
+     */
+    PALETTE_INDEX,
+    U,
+    V,
+    W,
+    Q,
+    /**
+     * Luminance, as used by UVLX8888.
+     */
+    L,
+    /**
+     * Padding which should be ignored.
+     */
+    UNUSED,
+  };
+
+  /**
+   * Compile time description of an image format's memory layout.
+   */
+  struct FormatTraits {
+    /**
+     * Name of the ImageFormat enum value.
+     */
+    std::string_view name;
+    /**
+     * Width of each block in pixels. Uncompressed formats use 1x1 blocks, which are single pixels.
+     */
+    uint8_t blockWidth;
+    /**
+     * Height of each block in pixels.
+     */
+    uint8_t blockHeight;
+    /**
+     * Size of each block in bytes. Zero for formats with no defined layout (NONE).
+     */
+    uint8_t bytesPerBlock;
+    /**
+     * Number of channels in each pixel.
+     */
+    uint8_t channelCount;
+    /**
+     * Channels in the order given by the format's name.
+     * @remark For byte aligned channels this is the order in memory.
+     * @remark For packed formats (e.g. BGR565) the first channel occupies the least significant bits.
+     */
+    std::array<Channel, 4> channels;
+    /**
+     * Number of bits used by each channel. Zero for compressed formats.
+     */
+    std::array<uint8_t, 4> channelBits;
+    /**
+     * Whether the format is block compressed (DXT).
+     */
+    bool compressed;
+    /**
+     * Whether the channels are stored as floating point numbers.
+     */
+    bool floatingPoint;
+  };
+
+  namespace FormatTraitsTable {
+    using enum Channel;
+
+    constexpr FormatTraits uncompressed(
+      const std::string_view name,
+      const uint8_t bytesPerPixel,
+      const std::array<Channel, 4> channels,
+      const std::array<uint8_t, 4> channelBits,
+      const bool floatingPoint = false
+    ) {
+      uint8_t channelCount = 0;
+      while (channelCount < 4 && channels[channelCount] != NONE) {
+        channelCount++;
+      }
+
+      return {
+        .name = name,
+        .blockWidth = 1,
+        .blockHeight = 1,
+        .bytesPerBlock = bytesPerPixel,
+        .channelCount = channelCount,
+        .channels = channels,
+        .channelBits = channelBits,
+        .compressed = false,
+        .floatingPoint = floatingPoint,
+      };
+    }
+
+    constexpr FormatTraits compressed(const std::string_view name, const uint8_t bytesPerBlock) {
+      return {
+        .name = name,
+        .blockWidth = 4,
+        .blockHeight = 4,
+        .bytesPerBlock = bytesPerBlock,
+        .channelCount = 4,
+        .channels = {RED, GREEN, BLUE, ALPHA},
+        .channelBits = {},
+        .compressed = true,
+        .floatingPoint = false,
+      };
+    }
+
+    /**
+     * Traits of every format, indexed by the format's value plus one.
+     */
+    constexpr std::array<FormatTraits, IMAGE_FORMAT_COUNT> TRAITS = {
+      FormatTraits{
+        .name = "NONE",
+        .blockWidth = 1,
+        .blockHeight = 1,
+        .bytesPerBlock = 0,
+        .channelCount = 0,
+        .channels = {},
+        .channelBits = {},
+        .compressed = false,
+        .floatingPoint = false,
+      },
+      uncompressed("RGBA8888", 4, {RED, GREEN, BLUE, ALPHA}, {8, 8, 8, 8}),
+      uncompressed("ABGR8888", 4, {ALPHA, BLUE, GREEN, RED}, {8, 8, 8, 8}),
+      uncompressed("RGB888", 3, {RED, GREEN, BLUE}, {8, 8, 8}),
+      uncompressed("BGR888", 3, {BLUE, GREEN, RED}, {8, 8, 8}),
+      uncompressed("RGB565", 2, {RED, GREEN, BLUE}, {5, 6, 5}),
+      uncompressed("I8", 1, {INTENSITY}, {8}),
+      uncompressed("IA88", 2, {INTENSITY, ALPHA}, {8, 8}),
+      uncompressed("P8", 1, {PALETTE_INDEX}, {8}),
+      uncompressed("A8", 1, {ALPHA}, {8}),
+      uncompressed("RGB888_BLUESCREEN", 3, {RED, GREEN, BLUE}, {8, 8, 8}),
+      uncompressed("BGR888_BLUESCREEN", 3, {BLUE, GREEN, RED}, {8, 8, 8}),
+      uncompressed("ARGB8888", 4, {ALPHA, RED, GREEN, BLUE}, {8, 8, 8, 8}),
+      uncompressed("BGRA8888", 4, {BLUE, GREEN, RED, ALPHA}, {8, 8, 8, 8}),
+      compressed("DXT1", 8),
+      compressed("DXT3", 16),
+      compressed("DXT5", 16),
+      uncompressed("BGRX8888", 4, {BLUE, GREEN, RED, UNUSED}, {8, 8, 8, 8}),
+      uncompressed("BGR565", 2, {BLUE, GREEN, RED}, {5, 6, 5}),
+      uncompressed("BGRX5551", 2, {BLUE, GREEN, RED, UNUSED}, {5, 5, 5, 1}),
+      uncompressed("BGRA4444", 2, {BLUE, GREEN, RED, ALPHA}, {4, 4, 4, 4}),
+      compressed("DXT1_ONEBITALPHA", 8),
+      uncompressed("BGRA5551", 2, {BLUE, GREEN, RED, ALPHA}, {5, 5, 5, 1}),
+      uncompressed("UV88", 2, {U, V}, {8, 8}),
+      uncompressed("UVWQ8888", 4, {U, V, W, Q}, {8, 8, 8, 8}),
+      uncompressed("RGBA16161616F", 8, {RED, GREEN, BLUE, ALPHA}, {16, 16, 16, 16}, true),
+      uncompressed("RGBA16161616", 8, {RED, GREEN, BLUE, ALPHA}, {16, 16, 16, 16}),
+      uncompressed("UVLX8888", 4, {U, V, L, UNUSED}, {8, 8, 8, 8}),
+    };
+  }
+
+  /**
+   * Gets the memory layout of the given format.
+   * @param format
+   * @return Traits of the format.
+   * @throws Errors::InvalidHeader if the format is not a known ImageFormat.
+   */
+  constexpr const FormatTraits& getFormatTraits(const ImageFormat format) {
+    const auto index = static_cast<size_t>(static_cast<int64_t>(format) + 1);
+    if (index >= IMAGE_FORMAT_COUNT) {
+      throw Errors::InvalidHeader("Unrecognised image format");
+    }
+
+    return FormatTraitsTable::TRAITS[index];
+  }
+
+  /**
+   * Traits of a format known at compile time.
+   * @tparam Format
+   */
+  template <ImageFormat Format>
+  constexpr const FormatTraits& FORMAT_TRAITS = getFormatTraits(Format);
+
+  /**
+   * Checks whether a format stores more than 8 bits per channel.
+   * @param traits
+   * @return True for floating point and 16-bit formats.
+   */
+  constexpr bool isHighDynamicRange(const FormatTraits& traits) {
+    return traits.floatingPoint || traits.channelBits[0] > 8;
+  }
+
+  /**
+   * Gets the size of a single 2D image slice.
+   * @param traits Traits of the slice's format.
+   * @param width Width of the slice in pixels.
+   * @param height Height of the slice in pixels.
+   * @return Size of the slice in bytes, rounded up to whole blocks.
+   */
+  constexpr size_t getSliceSizeBytes(const FormatTraits& traits, const size_t width, const size_t height) {
+    const size_t blocksWide = (width + traits.blockWidth - 1) / traits.blockWidth;
+    const size_t blocksHigh = (height + traits.blockHeight - 1) / traits.blockHeight;
+
+    return blocksWide * blocksHigh * traits.bytesPerBlock;
+  }
+
+  static_assert(getSliceSizeBytes(FORMAT_TRAITS<ImageFormat::DXT1>, 1, 1) == 8);
+  static_assert(getSliceSizeBytes(FORMAT_TRAITS<ImageFormat::DXT5>, 256, 128) == 256 * 128);
+  static_assert(getSliceSizeBytes(FORMAT_TRAITS<ImageFormat::BGR888>, 3, 5) == 3 * 5 * 3);
+  static_assert(getSliceSizeBytes(FORMAT_TRAITS<ImageFormat::NONE>, 0, 0) == 0);
+}
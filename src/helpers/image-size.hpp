@@ -0,0 +1,59 @@
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include "../format-traits.hpp"
+
+namespace VtfParser {
+  struct ImageSizeInfo {
+    ImageFormat format;
+    size_t width;
+    size_t height;
+    size_t depth;
+    size_t faces;
+    size_t frames;
+    uint8_t mipLevels;
+  };
+
+  /**
+   * Gets the number of cubemap faces a texture has.
+   * @param flags Flags of the texture.
+   * @param firstFrame First frame of the texture's animation.
+   * @param minorVersion Minor version of the file format.
+   * @return 6 or 7 for environment maps and 1 for anything else.
+   */
+  inline uint8_t getFaceCount(const TextureFlags flags, const uint16_t firstFrame, const uint32_t minorVersion) {
+    if ((flags & TextureFlags::ENVMAP) == TextureFlags::NONE) {
+      return 1;
+    }
+
+    return firstFrame == 0xffff && minorVersion < 5 ? 7 : 6;
+  }
+
+  /**
+   * Gets the combined size of every mip level from firstMipLevel down to the smallest.
+   * @param sizeInfo Size of the largest mip level.
+   * @param firstMipLevel Largest mip level to include.
+   * @return Size in bytes.
+   */
+  inline size_t getMipChainSizeBytes(const ImageSizeInfo& sizeInfo, const uint8_t firstMipLevel = 0) {
+    const auto& traits = getFormatTraits(sizeInfo.format);
+    const size_t slicesPerDepth = sizeInfo.faces * sizeInfo.frames;
+
+    size_t size = 0;
+    for (uint8_t mipLevel = firstMipLevel; mipLevel < sizeInfo.mipLevels; mipLevel++) {
+      const auto width = std::max<size_t>(sizeInfo.width >> mipLevel, 1);
+      const auto height = std::max<size_t>(sizeInfo.height >> mipLevel, 1);
+      const auto depth = std::max<size_t>(sizeInfo.depth >> mipLevel, 1);
+
+      size += getSliceSizeBytes(traits, width, height) * depth * slicesPerDepth;
+    }
+
+    return size;
+  }
+
+  inline size_t getImageSizeBytes(const ImageSizeInfo& sizeInfo) {
+    return getMipChainSizeBytes(sizeInfo);
+  }
+}
@@ -0,0 +1,76 @@
+#pragma once
+
+#include <array>
+#include <cstring>
+#include <span>
+#include "check-bounds.hpp"
+#include "image-size.hpp"
+#include "../errors.hpp"
+#include "../file-format-objects/header.hpp"
+
+namespace VtfParser {
+  constexpr std::array<char, 4> FILE_ID = { 'V', 'T', 'F', 0 };
+
+  constexpr uint32_t SUPPORTED_MAJOR_VERSION = 7;
+  constexpr uint32_t MIN_SUPPORTED_MINOR_VERSION = 0;
+  constexpr uint32_t MAX_SUPPORTED_MINOR_VERSION = 5;
+
+  /**
+   * First minor version with resource infos.
+   */
+  constexpr uint32_t MIN_RESOURCE_INFO_MINOR_VERSION = 3;
+
+  constexpr std::array<uint8_t, 3> LOW_RES_RESOURCE_TAG = { 0x01, 0, 0 };
+  constexpr std::array<uint8_t, 3> HIGH_RES_RESOURCE_TAG = { 0x30, 0, 0 };
+
+  /**
+   * Copies the header out of the data, validates it and fixes up fields which older versions leave as garbage.
+   * @param data Binary data starting with the header.
+   * @return Validated header.
+   */
+  inline Header parseHeader(const std::span<const std::byte> data) {
+    checkBounds(0, sizeof(Header), data.size(), "Failed to parse VTF header");
+    auto header = *reinterpret_cast<const Header*>(data.data());
+
+    if (memcmp(header.signature.data(), FILE_ID.data(), 4) != 0) {
+      throw Errors::InvalidHeader("VTF header has an invalid file ID");
+    }
+
+    if (header.version[0] != SUPPORTED_MAJOR_VERSION || header.version[1] < MIN_SUPPORTED_MINOR_VERSION || header.
+      version[1] > MAX_SUPPORTED_MINOR_VERSION) {
+      throw Errors::UnsupportedVersion("VTF version is not supported");
+    }
+
+    // Fix-up for old versions of the format, which put garbage data here
+    if (header.version[1] < 2) {
+      header.depth = 1;
+    }
+    if (header.version[1] < MIN_RESOURCE_INFO_MINOR_VERSION) {
+      header.numResources = 0;
+    }
+
+    if (header.highResImageFormat == ImageFormat::NONE) {
+      throw Errors::InvalidHeader("VTF high res image format is NONE");
+    }
+
+    if (header.numResources > Header::MAX_RESOURCES) {
+      throw Errors::InvalidHeader("VTF resource count is higher than maximum allowed");
+    }
+
+    return header;
+  }
+
+  inline size_t getLowResImageSizeBytes(const Header& header) {
+    return getImageSizeBytes(
+      {
+        .format = header.lowResImageFormat,
+        .width = header.lowResImageWidth,
+        .height = header.lowResImageHeight,
+        .depth = 1,
+        .faces = 1,
+        .frames = 1,
+        .mipLevels = 1,
+      }
+    );
+  }
+}
@@ -0,0 +1,162 @@
+#pragma once
+
+#include <algorithm>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <exception>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace VtfParser {
+  /**
+   * Fixed set of worker threads which can be reused for many parallel loops.
+   * @remark The thread calling parallelFor() also does work, so a pool of one thread starts no workers.
+   * @remark Only one parallelFor() may run on a pool at a time.
+   */
+  class ThreadPool {
+  public:
+    /**
+     * Starts the worker threads.
+     * @param threadCount Maximum number of threads to use, including the calling thread. Zero uses one per hardware thread.
+     */
+    explicit ThreadPool(size_t threadCount) {
+      if (threadCount == 0) {
+        threadCount = std::max<size_t>(std::thread::hardware_concurrency(), 1);
+      }
+
+      workers.reserve(threadCount - 1);
+      for (size_t i = 1; i < threadCount; i++) {
+        workers.emplace_back([this] { runWorker(); });
+      }
+    }
+
+    ~ThreadPool() {
+      {
+        std::lock_guard lock(mutex);
+        stopping = true;
+      }
+      workAvailable.notify_all();
+
+      for (auto& worker : workers) {
+        worker.join();
+      }
+    }
+
+    ThreadPool(const ThreadPool&) = delete;
+    ThreadPool& operator=(const ThreadPool&) = delete;
+
+    /**
+     * Splits [0, count) into contiguous ranges and calls the function with each range, spread over the pool.
+     * @remark If the function throws, the remaining ranges still run and the first range's exception is rethrown.
+     * @param count Number of items.
+     * @param function Callable taking the (begin, end) of a range.
+     * @param minimumPerRange Smallest number of items worth handing to another thread.
+     * Loops with fewer items than this run entirely on the calling thread.
+     */
+    template <typename Function>
+    void parallelFor(const size_t count, const Function& function, const size_t minimumPerRange = 1) {
+      const size_t maxRanges = std::max<size_t>(count / std::max<size_t>(minimumPerRange, 1), 1);
+      const size_t rangeCount = std::min(workers.size() + 1, maxRanges);
+
+      if (rangeCount <= 1) {
+        function(size_t{0}, count);
+        return;
+      }
+
+      const size_t rangeSize = (count + rangeCount - 1) / rangeCount;
+      const size_t usedRangeCount = (count + rangeSize - 1) / rangeSize;
+
+      // Exceptions cannot leave a worker thread, so they are handed back to the calling thread
+      std::vector<std::exception_ptr> exceptions(usedRangeCount);
+      const std::function<void(size_t)> task = [&function, &exceptions, rangeSize, count](const size_t range) {
+        try {
+          const auto begin = range * rangeSize;
+          function(begin, std::min(begin + rangeSize, count));
+        } catch (...) {
+          exceptions[range] = std::current_exception();
+        }
+      };
+
+      run(task, usedRangeCount);
+
+      for (const auto& exception : exceptions) {
+        if (exception) {
+          std::rethrow_exception(exception);
+        }
+      }
+    }
+
+  private:
+    std::mutex mutex;
+    std::condition_variable workAvailable;
+    std::condition_variable tasksFinished;
+    const std::function<void(size_t)>* currentTask = nullptr;
+    size_t taskCount = 0;
+    size_t nextTask = 0;
+    size_t unfinishedTasks = 0;
+    uint64_t generation = 0;
+    bool stopping = false;
+    std::vector<std::thread> workers;
+
+    void run(const std::function<void(size_t)>& task, const size_t count) {
+      {
+        std::lock_guard lock(mutex);
+        currentTask = &task;
+        taskCount = count;
+        nextTask = 0;
+        unfinishedTasks = count;
+        generation++;
+      }
+      workAvailable.notify_all();
+
+      runTasks();
+
+      std::unique_lock lock(mutex);
+      tasksFinished.wait(lock, [this] { return unfinishedTasks == 0; });
+      currentTask = nullptr;
+    }
+
+    void runTasks() {
+      while (true) {
+        const std::function<void(size_t)>* task;
+        size_t index;
+        {
+          std::lock_guard lock(mutex);
+          if (currentTask == nullptr || nextTask >= taskCount) {
+            return;
+          }
+
+          task = currentTask;
+          index = nextTask++;
+        }
+
+        (*task)(index);
+
+        std::lock_guard lock(mutex);
+        if (--unfinishedTasks == 0) {
+          tasksFinished.notify_all();
+        }
+      }
+    }
+
+    void runWorker() {
+      uint64_t lastGeneration = 0;
+      while (true) {
+        {
+          std::unique_lock lock(mutex);
+          workAvailable.wait(lock, [this, lastGeneration] { return stopping || generation != lastGeneration; });
+          if (stopping) {
+            return;
+          }
+
+          lastGeneration = generation;
+        }
+
+        runTasks();
+      }
+    }
+  };
+}
@@ -0,0 +1,225 @@
+#include "instrumentation.hpp"
+#include <atomic>
+#include <mutex>
+#include <sstream>
+#include <string_view>
+#include <vector>
+
+namespace VtfParser::Instrumentation {
+  namespace {
+    constexpr std::array<std::string_view, Errors::REASON_COUNT> REASON_NAMES = {
+      "InvalidHeader",
+      "UnsupportedVersion",
+      "OutOfBoundsAccess",
+      "UnsupportedImageFormat",
+      "InvalidArgument",
+    };
+
+#ifdef VTFPARSER_INSTRUMENTATION
+    /**
+     * Counters owned by a single thread.
+     * Only the owning thread writes to them, so updates never contend and readers only need relaxed loads.
+     */
+    struct ThreadCounters {
+      struct Format {
+        std::atomic<uint64_t> operations;
+        std::atomic<uint64_t> bytes;
+        std::atomic<uint64_t> nanoseconds;
+      };
+
+      std::atomic<uint64_t> vtfConstructions;
+      std::atomic<uint64_t> parseNanoseconds;
+      std::atomic<uint64_t> bytesTouched;
+      std::atomic<uint64_t> cacheHits;
+      std::atomic<uint64_t> cacheMisses;
+      std::array<Format, IMAGE_FORMAT_COUNT> formats;
+      std::array<std::atomic<uint64_t>, Errors::REASON_COUNT> errors;
+    };
+
+    void add(std::atomic<uint64_t>& counter, const uint64_t value) {
+      counter.store(counter.load(std::memory_order_relaxed) + value, std::memory_order_relaxed);
+    }
+
+    uint64_t load(const std::atomic<uint64_t>& counter) {
+      return counter.load(std::memory_order_relaxed);
+    }
+
+    void accumulate(Snapshot& snapshot, const ThreadCounters& counters) {
+      snapshot.vtfConstructions += load(counters.vtfConstructions);
+      snapshot.parseNanoseconds += load(counters.parseNanoseconds);
+      snapshot.bytesTouched += load(counters.bytesTouched);
+      snapshot.cacheHits += load(counters.cacheHits);
+      snapshot.cacheMisses += load(counters.cacheMisses);
+
+      for (size_t i = 0; i < IMAGE_FORMAT_COUNT; i++) {
+        snapshot.formats[i].operations += load(counters.formats[i].operations);
+        snapshot.formats[i].bytes += load(counters.formats[i].bytes);
+        snapshot.formats[i].nanoseconds += load(counters.formats[i].nanoseconds);
+      }
+
+      for (size_t i = 0; i < Errors::REASON_COUNT; i++) {
+        snapshot.errors[i] += load(counters.errors[i]);
+      }
+    }
+
+    struct Registry {
+      std::mutex mutex;
+      std::vector<const ThreadCounters*> threads;
+      /**
+       * Totals of threads that have exited, so the registry only grows with the number of live threads.
+       */
+      Snapshot retired{};
+    };
+
+    Registry& getRegistry() {
+      static Registry registry;
+      return registry;
+    }
+
+    /**
+     * Registers a thread's counters for its lifetime, folding them into the retired totals when the thread exits.
+     */
+    class RegisteredThreadCounters {
+    public:
+      RegisteredThreadCounters() {
+        auto& registry = getRegistry();
+        std::lock_guard lock(registry.mutex);
+        registry.threads.push_back(&counters);
+      }
+
+      ~RegisteredThreadCounters() {
+        auto& registry = getRegistry();
+        std::lock_guard lock(registry.mutex);
+        accumulate(registry.retired, counters);
+        std::erase(registry.threads, &counters);
+      }
+
+      RegisteredThreadCounters(const RegisteredThreadCounters&) = delete;
+      RegisteredThreadCounters& operator=(const RegisteredThreadCounters&) = delete;
+
+      ThreadCounters counters{};
+    };
+
+    ThreadCounters& getThreadCounters() {
+      thread_local RegisteredThreadCounters registered;
+      return registered.counters;
+    }
+#endif
+  }
+  Snapshot getSnapshot() {
+    Snapshot snapshot{};
+
+#ifdef VTFPARSER_INSTRUMENTATION
+    auto& registry = getRegistry();
+    std::lock_guard lock(registry.mutex);
+
+    snapshot = registry.retired;
+    for (const auto* thread : registry.threads) {
+      accumulate(snapshot, *thread);
+    }
+#endif
+
+    return snapshot;
+  }
+
+  std::string toPrometheusText(const Snapshot& snapshot) {
+    std::ostringstream stream;
+
+    const auto writeType = [&stream](const std::string_view name) {
+      stream << "# TYPE vtfparser_" << name << " counter\n";
+    };
+
+    writeType("vtf_constructions_total");
+    stream << "vtfparser_vtf_constructions_total " << snapshot.vtfConstructions << '\n';
+    writeType("parse_nanoseconds_total");
+    stream << "vtfparser_parse_nanoseconds_total " << snapshot.parseNanoseconds << '\n';
+    writeType("bytes_touched_total");
+    stream << "vtfparser_bytes_touched_total " << snapshot.bytesTouched << '\n';
+
+    writeType("cache_lookups_total");
+    stream << "vtfparser_cache_lookups_total{result=\"hit\"} " << snapshot.cacheHits << '\n';
+    stream << "vtfparser_cache_lookups_total{result=\"miss\"} " << snapshot.cacheMisses << '\n';
+
+    const auto writeFormatCounter = [&](const std::string_view name, uint64_t FormatStatistics::* member) {
+      writeType(name);
+      for (size_t i = 0; i < IMAGE_FORMAT_COUNT; i++) {
+        if (snapshot.formats[i].operations == 0) {
+          continue;
+        }
+
+        const auto formatName = FormatTraitsTable::TRAITS[i].name;
+        stream << "vtfparser_" << name << "{format=\"" << formatName << "\"} " << snapshot.formats[i].*member << '\n';
+      }
+    };
+
+    writeFormatCounter("format_operations_total", &FormatStatistics::operations);
+    writeFormatCounter("format_bytes_total", &FormatStatistics::bytes);
+    writeFormatCounter("format_nanoseconds_total", &FormatStatistics::nanoseconds);
+
+    writeType("errors_total");
+    for (size_t i = 0; i < Errors::REASON_COUNT; i++) {
+      stream << "vtfparser_errors_total{reason=\"" << REASON_NAMES[i] << "\"} " << snapshot.errors[i] << '\n';
+    }
+
+    return stream.str();
+  }
+
+  std::string toJson(const Snapshot& snapshot) {
+    std::ostringstream stream;
+
+    stream << "{\"vtfConstructions\":" << snapshot.vtfConstructions;
+    stream << ",\"parseNanoseconds\":" << snapshot.parseNanoseconds;
+    stream << ",\"bytesTouched\":" << snapshot.bytesTouched;
+    stream << ",\"cacheHits\":" << snapshot.cacheHits;
+    stream << ",\"cacheMisses\":" << snapshot.cacheMisses;
+
+    stream << ",\"formats\":{";
+    bool first = true;
+    for (size_t i = 0; i < IMAGE_FORMAT_COUNT; i++) {
+      const auto& format = snapshot.formats[i];
+      if (format.operations == 0) {
+        continue;
+      }
+
+      stream << (first ? "" : ",") << '"' << FormatTraitsTable::TRAITS[i].name << "\":{";
+      stream << "\"operations\":" << format.operations << ",\"bytes\":" << format.bytes;
+      stream << ",\"nanoseconds\":" << format.nanoseconds << '}';
+      first = false;
+    }
+
+    stream << "},\"errors\":{";
+    for (size_t i = 0; i < Errors::REASON_COUNT; i++) {
+      stream << (i == 0 ? "" : ",") << '"' << REASON_NAMES[i] << "\":" << snapshot.errors[i];
+    }
+    stream << "}}";
+
+    return stream.str();
+  }
+
+#ifdef VTFPARSER_INSTRUMENTATION
+  void recordConstruction(const uint64_t nanoseconds, const uint64_t bytes) {
+    auto& counters = getThreadCounters();
+    add(counters.vtfConstructions, 1);
+    add(counters.parseNanoseconds, nanoseconds);
+    add(counters.bytesTouched, bytes);
+  }
+
+  void recordFormatThroughput(const ImageFormat format, const uint64_t bytes, const uint64_t nanoseconds) {
+    auto& counters = getThreadCounters();
+    auto& formatCounters = counters.formats[static_cast<size_t>(static_cast<int32_t>(format) + 1)];
+    add(formatCounters.operations, 1);
+    add(formatCounters.bytes, bytes);
+    add(formatCounters.nanoseconds, nanoseconds);
+    add(counters.bytesTouched, bytes);
+  }
+
+  void recordError(const Errors::Reason reason) {
+    add(getThreadCounters().errors[static_cast<size_t>(reason)], 1);
+  }
+
+  void recordCacheLookup(const bool hit) {
+    auto& counters = getThreadCounters();
+    add(hit ? counters.cacheHits : counters.cacheMisses, 1);
+  }
+#endif
+}
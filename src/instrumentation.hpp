@@ -0,0 +1,151 @@
+#pragma once
+
+#include <array>
+#include <chrono>
+#include <cstdint>
+#include <string>
+#include "errors.hpp"
+#include "format-traits.hpp"
+
+/**
+ * Opt-in statistics about the library's hot paths.
+ * @remark Only collected when compiled with VTFPARSER_INSTRUMENTATION defined (the CMake option of the same name).
+ * @remark Otherwise every recording function is an empty inline and snapshots are always zeroed.
+ */
+namespace VtfParser::Instrumentation {
+  /**
+   * Whether the library was compiled with instrumentation.
+   * @return True if statistics are being collected.
+   */
+  constexpr bool isEnabled() {
+#ifdef VTFPARSER_INSTRUMENTATION
+    return true;
+#else
+    return false;
+#endif
+  }
+
+  /**
+   * Decode and conversion statistics for a single image format.
+   */
+  struct FormatStatistics {
+    /**
+     * Number of decode or conversion operations.
+     */
+    uint64_t operations;
+    /**
+     * Number of bytes of image data processed.
+     */
+    uint64_t bytes;
+    /**
+     * Time spent processing, in nanoseconds.
+     */
+    uint64_t nanoseconds;
+  };
+
+  /**
+   * Statistics aggregated across all threads at a point in time.
+   */
+  struct Snapshot {
+    /**
+     * Number of successful Vtf constructions.
+     */
+    uint64_t vtfConstructions;
+    /**
+     * Time spent in successful Vtf constructions, in nanoseconds.
+     */
+    uint64_t parseNanoseconds;
+    /**
+     * Number of bytes of input read while parsing, decoding or converting.
+     * @remark Parsing only counts the header and resource dictionary, as image data is not read until it is decoded.
+     */
+    uint64_t bytesTouched;
+    /**
+     * Number of catalog lookups which found an entry.
+     */
+    uint64_t cacheHits;
+    /**
+     * Number of catalog lookups which found nothing.
+     */
+    uint64_t cacheMisses;
+    /**
+     * Statistics for each format, indexed by the format's value plus one.
+     */
+    std::array<FormatStatistics, IMAGE_FORMAT_COUNT> formats;
+    /**
+     * Number of errors thrown for each reason, indexed by the reason's value.
+     */
+    std::array<uint64_t, Errors::REASON_COUNT> errors;
+
+    /**
+     * Gets the statistics for a single format.
+     * @param format
+     * @return Decode and conversion statistics.
+     */
+    [[nodiscard]] const FormatStatistics& getFormat(const ImageFormat format) const {
+      return formats[static_cast<size_t>(static_cast<int32_t>(format) + 1)];
+    }
+
+    /**
+     * Gets the number of errors thrown for a single reason.
+     * @param reason
+     * @return Error count.
+     */
+    [[nodiscard]] uint64_t getErrors(const Errors::Reason reason) const {
+      return errors[static_cast<size_t>(reason)];
+    }
+  };
+
+  /**
+   * Sums the counters of every thread that has recorded statistics.
+   * @remark Counters are updated without locking, so a snapshot taken while other threads are working may be slightly behind.
+   * @return Aggregated statistics, or all zeros if instrumentation is compiled out.
+   */
+  [[nodiscard]] Snapshot getSnapshot();
+
+  /**
+   * Formats a snapshot in the Prometheus text exposition format.
+   * @param snapshot
+   * @return Metrics prefixed with "vtfparser_".
+   */
+  [[nodiscard]] std::string toPrometheusText(const Snapshot& snapshot);
+
+  /**
+   * Formats a snapshot as a JSON object.
+   * @param snapshot
+   * @return JSON text.
+   */
+  [[nodiscard]] std::string toJson(const Snapshot& snapshot);
+
+#ifdef VTFPARSER_INSTRUMENTATION
+  /**
+   * Measures the time elapsed since construction.
+   */
+  class ScopedTimer {
+  public:
+    [[nodiscard]] uint64_t getElapsedNanoseconds() const {
+      return std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - start).count();
+    }
+
+  private:
+    std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+  };
+
+  void recordConstruction(uint64_t nanoseconds, uint64_t bytes);
+  void recordFormatThroughput(ImageFormat format, uint64_t bytes, uint64_t nanoseconds);
+  void recordError(Errors::Reason reason);
+  void recordCacheLookup(bool hit);
+#else
+  class ScopedTimer {
+  public:
+    [[nodiscard]] uint64_t getElapsedNanoseconds() const {
+      return 0;
+    }
+  };
+
+  inline void recordConstruction(uint64_t, uint64_t) {}
+  inline void recordFormatThroughput(ImageFormat, uint64_t, uint64_t) {}
+  inline void recordError(Errors::Reason) {}
+  inline void recordCacheLookup(bool) {}
+#endif
+}
@@ -0,0 +1,353 @@
+#include "resampler.hpp"
+#include <algorithm>
+#include <cmath>
+#include <numbers>
+#include "colour-space.hpp"
+#include "errors.hpp"
+#include "writer.hpp"
+#include "helpers/thread-pool.hpp"
+
+namespace VtfParser {
+  using namespace Errors;
+
+  namespace {
+    /**
+     * Fewest rows worth handing to another thread. Smaller images (such as the tail of a mip chain) run inline.
+     */
+    constexpr size_t MINIMUM_ROWS_PER_THREAD = 16;
+
+    struct Filter {
+      float radius;
+      float (*weight)(float);
+    };
+
+    float sinc(const float x) {
+      if (x == 0.0f) {
+        return 1.0f;
+      }
+
+      const float piX = std::numbers::pi_v<float> * x;
+      return std::sin(piX) / piX;
+    }
+
+    float lanczos3(const float x) {
+      return std::abs(x) < 3.0f ? sinc(x) * sinc(x / 3.0f) : 0.0f;
+    }
+
+    float mitchell(float x) {
+      constexpr float B = 1.0f / 3.0f;
+      constexpr float C = 1.0f / 3.0f;
+
+      x = std::abs(x);
+      if (x < 1.0f) {
+        return ((12.0f - 9.0f * B - 6.0f * C) * x * x * x + (-18.0f + 12.0f * B + 6.0f * C) * x * x + (6.0f - 2.0f * B))
+          / 6.0f;
+      }
+      if (x < 2.0f) {
+        return ((-B - 6.0f * C) * x * x * x + (6.0f * B + 30.0f * C) * x * x + (-12.0f * B - 48.0f * C) * x
+          + (8.0f * B + 24.0f * C)) / 6.0f;
+      }
+
+      return 0.0f;
+    }
+
+    Filter getFilter(const ResampleFilter filter) {
+      switch (filter) {
+        case ResampleFilter::MITCHELL:
+          return {.radius = 2.0f, .weight = mitchell};
+        default:
+          return {.radius = 3.0f, .weight = lanczos3};
+      }
+    }
+
+    /**
+     * Precomputed filter taps mapping each destination pixel on one axis to a run of source pixels.
+     * Weights are stored with a fixed stride so the inner loops have no indirection.
+     */
+    struct Contributions {
+      size_t tapsPerPixel;
+      std::vector<size_t> firstSource;
+      std::vector<size_t> tapCounts;
+      std::vector<float> weights;
+    };
+
+    Contributions computeContributions(const size_t sourceSize, const size_t targetSize, const Filter& filter) {
+      const float scale = static_cast<float>(targetSize) / static_cast<float>(sourceSize);
+      // Widen the filter when downscaling so every source pixel contributes
+      const float filterScale = std::max(1.0f / scale, 1.0f);
+      const float support = filter.radius * filterScale;
+
+      Contributions contributions = {
+        .tapsPerPixel = static_cast<size_t>(std::ceil(support)) * 2 + 3,
+        .firstSource = std::vector<size_t>(targetSize),
+        .tapCounts = std::vector<size_t>(targetSize),
+        .weights = {},
+      };
+      contributions.weights.resize(targetSize * contributions.tapsPerPixel);
+
+      for (size_t target = 0; target < targetSize; target++) {
+        const float centre = (static_cast<float>(target) + 0.5f) / scale;
+        const auto first = static_cast<size_t>(std::max(std::floor(centre - support), 0.0f));
+        const auto last = std::min(static_cast<size_t>(std::ceil(centre + support)), sourceSize - 1);
+        const auto tapCount = std::min(last - first + 1, contributions.tapsPerPixel);
+
+        auto* weights = contributions.weights.data() + target * contributions.tapsPerPixel;
+        float total = 0.0f;
+        for (size_t tap = 0; tap < tapCount; tap++) {
+          const float distance = static_cast<float>(first + tap) + 0.5f - centre;
+          weights[tap] = filter.weight(distance / filterScale);
+          total += weights[tap];
+        }
+
+        if (total != 0.0f) {
+          for (size_t tap = 0; tap < tapCount; tap++) {
+            weights[tap] /= total;
+          }
+        }
+
+        contributions.firstSource[target] = first;
+        contributions.tapCounts[target] = tapCount;
+      }
+
+      return contributions;
+    }
+
+    void resampleRowsHorizontally(
+      const RgbaImage& source,
+      RgbaImage& target,
+      const Contributions& contributions,
+      const size_t firstRow,
+      const size_t lastRow
+    ) {
+      for (size_t y = firstRow; y < lastRow; y++) {
+        const auto* sourceRow = source.pixels.data() + y * source.width * 4;
+        auto* targetPixel = target.pixels.data() + y * target.width * 4;
+
+        for (size_t x = 0; x < target.width; x++, targetPixel += 4) {
+          const auto* sourcePixel = sourceRow + contributions.firstSource[x] * 4;
+          const auto* weights = contributions.weights.data() + x * contributions.tapsPerPixel;
+
+          // Channels are accumulated together so the compiler can keep the pixel in one vector register
+          float sum[4] = {};
+          for (size_t tap = 0; tap < contributions.tapCounts[x]; tap++, sourcePixel += 4) {
+            for (size_t channel = 0; channel < 4; channel++) {
+              sum[channel] += sourcePixel[channel] * weights[tap];
+            }
+          }
+
+          std::copy_n(sum, 4, targetPixel);
+        }
+      }
+    }
+
+    void resampleRowsVertically(
+      const RgbaImage& source,
+      RgbaImage& target,
+      const Contributions& contributions,
+      const size_t firstRow,
+      const size_t lastRow
+    ) {
+      const size_t rowLength = target.width * 4;
+
+      for (size_t y = firstRow; y < lastRow; y++) {
+        auto* targetRow = target.pixels.data() + y * rowLength;
+        const auto* weights = contributions.weights.data() + y * contributions.tapsPerPixel;
+
+        // Whole rows are blended at once, which is a contiguous multiply-add the compiler vectorises
+        std::fill_n(targetRow, rowLength, 0.0f);
+        for (size_t tap = 0; tap < contributions.tapCounts[y]; tap++) {
+          const auto* sourceRow = source.pixels.data() + (contributions.firstSource[y] + tap) * rowLength;
+          const float weight = weights[tap];
+
+          for (size_t i = 0; i < rowLength; i++) {
+            targetRow[i] += sourceRow[i] * weight;
+          }
+        }
+      }
+    }
+
+    RgbaImage resampleWithPool(
+      const RgbaImage& image,
+      const size_t width,
+      const size_t height,
+      const ResampleFilter filter,
+      ThreadPool& threadPool
+    ) {
+      if (width == 0 || height == 0 || image.width == 0 || image.height == 0) {
+        throw InvalidArgument("Cannot resample to or from an empty image");
+      }
+      if (image.pixels.size() != image.width * image.height * 4) {
+        throw InvalidArgument("Image pixels do not match its extents");
+      }
+
+      const auto filterInfo = getFilter(filter);
+
+      RgbaImage horizontal = {.width = width, .height = image.height, .pixels = {}};
+      horizontal.pixels.resize(width * image.height * 4);
+      if (width == image.width) {
+        horizontal.pixels = image.pixels;
+      } else {
+        const auto contributions = computeContributions(image.width, width, filterInfo);
+        threadPool.parallelFor(
+          image.height,
+          [&](const size_t firstRow, const size_t lastRow) {
+            resampleRowsHorizontally(image, horizontal, contributions, firstRow, lastRow);
+          },
+          MINIMUM_ROWS_PER_THREAD
+        );
+      }
+
+      if (height == image.height) {
+        return horizontal;
+      }
+
+      RgbaImage resampled = {.width = width, .height = height, .pixels = {}};
+      resampled.pixels.resize(width * height * 4);
+
+      const auto contributions = computeContributions(image.height, height, filterInfo);
+      threadPool.parallelFor(
+        height,
+        [&](const size_t firstRow, const size_t lastRow) {
+          resampleRowsVertically(horizontal, resampled, contributions, firstRow, lastRow);
+        },
+        MINIMUM_ROWS_PER_THREAD
+      );
+
+      return resampled;
+    }
+  }
+
+  RgbaImage resample(
+    const RgbaImage& image,
+    const size_t width,
+    const size_t height,
+    const ResampleFilter filter,
+    const size_t threadCount
+  ) {
+    ThreadPool threadPool(threadCount);
+    return resampleWithPool(image, width, height, filter, threadPool);
+  }
+
+  std::vector<std::byte> resampleVtf(
+    const Vtf& vtf,
+    const uint16_t width,
+    const uint16_t height,
+    const ResampleOptions& options
+  ) {
+    if (width == 0 || height == 0) {
+      throw InvalidArgument("Cannot resample to an empty image");
+    }
+
+    const auto sourceFormat = vtf.getHighResImageFormat();
+    const auto format = options.format != ImageFormat::NONE
+      ? options.format
+      : isHighDynamicRange(getFormatTraits(sourceFormat)) ? ImageFormat::RGBA16161616F : ImageFormat::BGRA8888;
+    if (!canEncode(format)) {
+      throw UnsupportedImageFormat("Resampled image format cannot be encoded");
+    }
+
+    // High dynamic range formats are always stored linear, whatever the flags say (see decodeSliceLinear())
+    const auto colourSpace = getColourSpace(vtf.getFlags());
+    const bool sourceIsSrgb = colourSpace == ColourSpace::SRGB && !isHighDynamicRange(getFormatTraits(sourceFormat));
+    const bool outputIsSrgb = colourSpace == ColourSpace::SRGB && !isHighDynamicRange(getFormatTraits(format));
+
+    // Changing colour space needs linear data, so filtering in gamma space is only possible when both sides are sRGB
+    const bool filterInLinearSpace = sourceIsSrgb && (options.linearise || !outputIsSrgb);
+    const bool needsSrgbEncode = outputIsSrgb && (filterInLinearSpace || !sourceIsSrgb);
+    const auto encode = [needsSrgbEncode, format](const RgbaImage& image) {
+      return encodeSlice(format, needsSrgbEncode ? toSrgb(image) : image);
+    };
+
+    // Textures flagged as having no mips are treated as a single image, whatever the file stores
+    const bool useMips = (vtf.getFlags() & TextureFlags::NOMIP) == TextureFlags::NONE && vtf.getMipLevels() > 1;
+
+    // Start from the smallest stored mip that still covers the target, as it is the cheapest to filter
+    uint8_t sourceMipLevel = 0;
+    const auto depth = vtf.getHighResImageExtent().depth;
+    if (useMips && depth == 1) {
+      while (sourceMipLevel + 1 < vtf.getMipLevels()) {
+        const auto extent = vtf.getHighResImageExtent(sourceMipLevel + 1);
+        if (extent.width < width || extent.height < height) {
+          break;
+        }
+        sourceMipLevel++;
+      }
+    }
+
+    // Volumetric mips also shrink in depth, which the 2D resampler cannot produce
+    uint8_t mipLevels = 1;
+    if (useMips && depth == 1) {
+      while ((width >> mipLevels) > 0 || (height >> mipLevels) > 0) {
+        mipLevels++;
+      }
+    }
+
+    const auto sourceExtent = vtf.getHighResImageExtent(sourceMipLevel);
+    // Shared by every resize so workers are started once per call rather than once per mip and slice
+    ThreadPool threadPool(options.threadCount);
+    const size_t slicesPerMip = static_cast<size_t>(vtf.getFrames()) * vtf.getFaces() * depth;
+
+    // Encoded slices for each mip level, largest first, in frame/face/depth order
+    std::vector<std::vector<std::vector<std::byte>>> mips(mipLevels);
+    for (auto& mip : mips) {
+      mip.reserve(slicesPerMip);
+    }
+
+    for (uint16_t frame = 0; frame < vtf.getFrames(); frame++) {
+      for (uint8_t face = 0; face < vtf.getFaces(); face++) {
+        for (uint16_t slice = 0; slice < depth; slice++) {
+          auto image = filterInLinearSpace
+            ? decodeSliceLinear(vtf, sourceMipLevel, frame, face, slice)
+            : decodeSlice(
+              sourceFormat,
+              vtf.getImageSliceData(sourceMipLevel, frame, face, slice),
+              sourceExtent.width,
+              sourceExtent.height
+            );
+
+          for (uint8_t mipLevel = 0; mipLevel < mipLevels; mipLevel++) {
+            image = resampleWithPool(
+              image,
+              std::max(width >> mipLevel, 1),
+              std::max(height >> mipLevel, 1),
+              options.filter,
+              threadPool
+            );
+            mips[mipLevel].push_back(encode(image));
+          }
+        }
+      }
+    }
+
+    std::vector<std::byte> highResImageData;
+    for (auto mip = mips.rbegin(); mip != mips.rend(); ++mip) {
+      for (const auto& slice : *mip) {
+        highResImageData.insert(highResImageData.end(), slice.begin(), slice.end());
+      }
+    }
+
+    const auto lowResExtent = vtf.getLowResImageExtent();
+    const auto lowResImageData = vtf.getLowResImageData();
+    const bool hasLowResImage = !lowResImageData.empty();
+
+    return writeVtf(
+      {
+        .highResImageFormat = format,
+        .width = width,
+        .height = height,
+        .depth = depth,
+        .flags = vtf.getFlags(),
+        .frames = vtf.getFrames(),
+        .firstFrame = vtf.getFirstFrame(),
+        .mipLevels = mipLevels,
+        .reflectivity = vtf.getReflectivity(),
+        .bumpmapScale = vtf.getBumpmapScale(),
+        .lowResImageFormat = hasLowResImage ? vtf.getLowResImageFormat() : ImageFormat::NONE,
+        .lowResImageWidth = hasLowResImage ? lowResExtent.width : uint8_t{0},
+        .lowResImageHeight = hasLowResImage ? lowResExtent.height : uint8_t{0},
+        .lowResImageData = lowResImageData,
+        .highResImageData = highResImageData,
+      }
+    );
+  }
+}
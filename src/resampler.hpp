@@ -0,0 +1,88 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+#include "codec.hpp"
+#include "vtf.hpp"
+
+namespace VtfParser {
+  /**
+   * Reconstruction filters available to the resampler.
+   */
+  enum class ResampleFilter : uint8_t {
+    /**
+     * Windowed sinc with a radius of 3 pixels. Sharpest results, with slight ringing on hard edges.
+     */
+    LANCZOS3,
+    /**
+     * Mitchell-Netravali cubic (B = C = 1/3). Softer than Lanczos, with almost no ringing.
+     */
+    MITCHELL,
+  };
+
+  /**
+   * Options for resampleVtf().
+   */
+  struct ResampleOptions {
+    /**
+     * Filter used for every resize.
+     */
+    ResampleFilter filter = ResampleFilter::LANCZOS3;
+    /**
+     * Format of the written high res image. NONE picks RGBA16161616F for high dynamic range sources and BGRA8888
+     * for everything else.
+     * @remark Must satisfy canEncode().
+     */
+    ImageFormat format = ImageFormat::NONE;
+    /**
+     * Whether to filter sRGB textures (see getColourSpace()) in linear space, which avoids darkening when downscaling.
+     * @remark The output is written in the colour space its flags and format declare either way. High dynamic range
+     * formats are always linear, so sRGB textures are filtered in linear space when written to one.
+     */
+    bool linearise = true;
+    /**
+     * Maximum number of threads to use. Zero uses one per hardware thread.
+     */
+    size_t threadCount = 0;
+  };
+
+  /**
+   * Resizes an image with a separable filter.
+   * @remark Each channel is filtered independently, so non-colour data (e.g. normal maps) is not affected by alpha.
+   * @param image Image to resize.
+   * @param width Target width in pixels.
+   * @param height Target height in pixels.
+   * @param filter Reconstruction filter.
+   * @param threadCount Maximum number of threads to use. Zero uses one per hardware thread.
+   * @return Resized image.
+   * @throws Errors::InvalidArgument if either size is zero or the image's pixels do not match its extents.
+   */
+  [[nodiscard]] RgbaImage resample(
+    const RgbaImage& image,
+    size_t width,
+    size_t height,
+    ResampleFilter filter = ResampleFilter::LANCZOS3,
+    size_t threadCount = 0
+  );
+
+  /**
+   * Writes a resized copy of a VTF.
+   * @remark Resamples from the smallest stored mip level that is at least the target size.
+   * Textures flagged with TextureFlags::NOMIP are resampled from mip level 0 instead.
+   * @remark The output keeps the flags, animation frames, cubemap faces and low res image of the source.
+   * @remark A full mip chain is generated if the source has more than one mip level,
+   * unless the texture is volumetric or flagged with TextureFlags::NOMIP.
+   * @param vtf VTF to resize.
+   * @param width Target width of the largest mip level.
+   * @param height Target height of the largest mip level.
+   * @param options
+   * @return Binary data of the new VTF (version 7.2).
+   */
+  [[nodiscard]] std::vector<std::byte> resampleVtf(
+    const Vtf& vtf,
+    uint16_t width,
+    uint16_t height,
+    const ResampleOptions& options = {}
+  );
+}
@@ -0,0 +1,168 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <span>
+#include <utility>
+#include "format-traits.hpp"
+#include "helpers/check-bounds.hpp"
+
+namespace VtfParser {
+  /**
+   * Typed view over a single 2D image slice whose format is known at compile time.
+   * @remark Lets consumers specialise their loops for a format with no per-pixel dispatch.
+   * @tparam Format Format of the slice.
+   */
+  template <ImageFormat Format>
+  class SliceView {
+  public:
+    static constexpr const FormatTraits& TRAITS = FORMAT_TRAITS<Format>;
+    static_assert(TRAITS.bytesPerBlock > 0, "Slices must have a format with a defined layout");
+
+    /**
+     * Raw bytes of a single block. For uncompressed formats each block is one pixel.
+     */
+    using Block = std::array<std::byte, TRAITS.bytesPerBlock>;
+
+    /**
+     * Creates a view over the slice given by the binary data.
+     * Does not take ownership of the data.
+     * @param data Slice data, e.g. from Vtf::getImageSliceData().
+     * @param width Width of the slice in pixels.
+     * @param height Height of the slice in pixels.
+     */
+    SliceView(const std::span<const std::byte> data, const size_t width, const size_t height) :
+      width(width),
+      height(height),
+      blocksWide((width + TRAITS.blockWidth - 1) / TRAITS.blockWidth),
+      blocksHigh((height + TRAITS.blockHeight - 1) / TRAITS.blockHeight) {
+      const auto sizeBytes = blocksWide * blocksHigh * sizeof(Block);
+      checkBounds(0, sizeBytes, data.size(), "Slice data is smaller than its extents");
+
+      blocks = std::span(reinterpret_cast<const Block*>(data.data()), blocksWide * blocksHigh);
+    }
+
+    /**
+     * Gets the width of the slice in pixels.
+     * @return Width in pixels.
+     */
+    [[nodiscard]] size_t getWidth() const {
+      return width;
+    }
+
+    /**
+     * Gets the height of the slice in pixels.
+     * @return Height in pixels.
+     */
+    [[nodiscard]] size_t getHeight() const {
+      return height;
+    }
+
+    /**
+     * Gets the number of blocks in each row. Equal to the width for uncompressed formats.
+     * @return Blocks per row.
+     */
+    [[nodiscard]] size_t getBlocksWide() const {
+      return blocksWide;
+    }
+
+    /**
+     * Gets the number of rows of blocks. Equal to the height for uncompressed formats.
+     * @return Number of block rows.
+     */
+    [[nodiscard]] size_t getBlocksHigh() const {
+      return blocksHigh;
+    }
+
+    /**
+     * Gets every block in the slice, in row-major order.
+     * @return View over the blocks.
+     */
+    [[nodiscard]] std::span<const Block> getBlocks() const {
+      return blocks;
+    }
+
+    /**
+     * Gets a single row of blocks.
+     * @param y Row index (in blocks).
+     * @return View over the row.
+     */
+    [[nodiscard]] std::span<const Block> getRow(const size_t y) const {
+      return blocks.subspan(y * blocksWide, blocksWide);
+    }
+
+    /**
+     * Gets a single block.
+     * @param x Column index (in blocks).
+     * @param y Row index (in blocks).
+     * @return Raw bytes of the block.
+     */
+    [[nodiscard]] const Block& getBlock(const size_t x, const size_t y) const {
+      return blocks[y * blocksWide + x];
+    }
+
+  private:
+    size_t width;
+    size_t height;
+    size_t blocksWide;
+    size_t blocksHigh;
+    std::span<const Block> blocks;
+  };
+
+  /**
+   * Calls the visitor with a SliceView specialised for the given runtime format.
+   * @param format Format of the slice.
+   * @param data Slice data.
+   * @param width Width of the slice in pixels.
+   * @param height Height of the slice in pixels.
+   * @param visitor Generic callable accepting any SliceView<Format>.
+   * @return Result of the visitor.
+   * @throws Errors::InvalidHeader if the format is NONE or unrecognised.
+   */
+  template <typename Visitor>
+  decltype(auto) visitSlice(
+    const ImageFormat format,
+    const std::span<const std::byte> data,
+    const size_t width,
+    const size_t height,
+    Visitor&& visitor
+  ) {
+#define VISIT_FORMAT(format) \
+  case ImageFormat::format: \
+    return std::forward<Visitor>(visitor)(SliceView<ImageFormat::format>(data, width, height));
+
+    switch (format) {
+      VISIT_FORMAT(RGBA8888)
+      VISIT_FORMAT(ABGR8888)
+      VISIT_FORMAT(RGB888)
+      VISIT_FORMAT(BGR888)
+      VISIT_FORMAT(RGB565)
+      VISIT_FORMAT(I8)
+      VISIT_FORMAT(IA88)
+      VISIT_FORMAT(P8)
+      VISIT_FORMAT(A8)
+      VISIT_FORMAT(RGB888_BLUESCREEN)
+      VISIT_FORMAT(BGR888_BLUESCREEN)
+      VISIT_FORMAT(ARGB8888)
+      VISIT_FORMAT(BGRA8888)
+      VISIT_FORMAT(DXT1)
+      VISIT_FORMAT(DXT3)
+      VISIT_FORMAT(DXT5)
+      VISIT_FORMAT(BGRX8888)
+      VISIT_FORMAT(BGR565)
+      VISIT_FORMAT(BGRX5551)
+      VISIT_FORMAT(BGRA4444)
+      VISIT_FORMAT(DXT1_ONEBITALPHA)
+      VISIT_FORMAT(BGRA5551)
+      VISIT_FORMAT(UV88)
+      VISIT_FORMAT(UVWQ8888)
+      VISIT_FORMAT(RGBA16161616F)
+      VISIT_FORMAT(RGBA16161616)
+      VISIT_FORMAT(UVLX8888)
+      default:
+        throw Errors::InvalidHeader("Unrecognised image format");
+    }
+
+#undef VISIT_FORMAT
+  }
+}
@@ -0,0 +1,138 @@
+#include "thumbnails.hpp"
+#include <algorithm>
+#include <cstring>
+#include "errors.hpp"
+#include "helpers/thread-pool.hpp"
+#include "helpers/parse-header.hpp"
+
+namespace VtfParser {
+  using namespace Errors;
+
+  Thumbnail readThumbnail(const RangeReader& read) {
+    // Zero filled so files shorter than the largest header still parse
+    std::array<std::byte, sizeof(Header)> headerData{};
+    const auto headerBytesRead = read(0, headerData);
+    checkBounds(0, sizeof(HeaderFullAligned), headerBytesRead, "Failed to read VTF header");
+
+    const auto header = parseHeader(headerData);
+
+    Thumbnail thumbnail = {.format = ImageFormat::NONE, .width = 0, .height = 0, .data = {}};
+    if (header.lowResImageFormat == ImageFormat::NONE) {
+      return thumbnail;
+    }
+
+    size_t offset = header.headerSize;
+    if (header.version[1] >= MIN_RESOURCE_INFO_MINOR_VERSION) {
+      const auto resourceInfos = std::span(header.resourceInfos).subspan(0, header.numResources);
+      const auto resourceInfo = std::ranges::find(resourceInfos, LOW_RES_RESOURCE_TAG, &ResourceEntryInfo::tag);
+      if (resourceInfo == resourceInfos.end()) {
+        return thumbnail;
+      }
+
+      offset = resourceInfo->data;
+    }
+
+    thumbnail.format = header.lowResImageFormat;
+    thumbnail.width = header.lowResImageWidth;
+    thumbnail.height = header.lowResImageHeight;
+    thumbnail.data.resize(getLowResImageSizeBytes(header));
+
+    if (read(offset, thumbnail.data) != thumbnail.data.size()) {
+      throw OutOfBoundsAccess("Failed to read VTF low res image data");
+    }
+
+    return thumbnail;
+  }
+
+  Thumbnail readThumbnail(const std::span<const std::byte> data) {
+    return readThumbnail(
+      [data](const size_t offset, const std::span<std::byte> buffer) -> size_t {
+        if (offset >= data.size()) {
+          return 0;
+        }
+
+        const auto count = std::min(buffer.size(), data.size() - offset);
+        memcpy(buffer.data(), data.data() + offset, count);
+        return count;
+      }
+    );
+  }
+
+  std::vector<Rgba8Image> decodeThumbnails(const std::span<const Thumbnail> thumbnails, const size_t threadCount) {
+    std::vector<Rgba8Image> images(thumbnails.size());
+    ThreadPool(threadCount).parallelFor(thumbnails.size(), [&](const size_t first, const size_t last) {
+      for (size_t i = first; i < last; i++) {
+        const auto& thumbnail = thumbnails[i];
+        if (thumbnail.format != ImageFormat::NONE) {
+          images[i] = decodeSliceRgba8(thumbnail.format, thumbnail.data, thumbnail.width, thumbnail.height);
+        }
+      }
+    });
+
+    return images;
+  }
+
+  ContactSheets buildContactSheets(const std::span<const Rgba8Image> images, const ContactSheetOptions& options) {
+    if (options.columns == 0 || options.rows == 0) {
+      throw InvalidArgument("Contact sheets must have at least one row and column");
+    }
+
+    size_t cellWidth = options.cellWidth;
+    size_t cellHeight = options.cellHeight;
+    for (const auto& image : images) {
+      if (options.cellWidth == 0) {
+        cellWidth = std::max(cellWidth, image.width);
+      } else if (image.width > cellWidth) {
+        throw InvalidArgument("Image is wider than the contact sheet cells");
+      }
+
+      if (options.cellHeight == 0) {
+        cellHeight = std::max(cellHeight, image.height);
+      } else if (image.height > cellHeight) {
+        throw InvalidArgument("Image is taller than the contact sheet cells");
+      }
+    }
+
+    const size_t cellsPerSheet = options.columns * options.rows;
+    const size_t sheetCount = (images.size() + cellsPerSheet - 1) / cellsPerSheet;
+
+    ContactSheets contactSheets;
+    contactSheets.sheets.resize(sheetCount);
+    contactSheets.cells.resize(images.size());
+
+    for (size_t sheet = 0; sheet < sheetCount; sheet++) {
+      const auto cellCount = std::min(cellsPerSheet, images.size() - sheet * cellsPerSheet);
+      const auto rows = (cellCount + options.columns - 1) / options.columns;
+
+      auto& image = contactSheets.sheets[sheet];
+      image.width = std::min(cellCount, options.columns) * cellWidth;
+      image.height = rows * cellHeight;
+      image.pixels.resize(image.width * image.height * 4);
+    }
+
+    // Every image writes to its own cell, so the copies need no synchronisation
+    ThreadPool(options.threadCount).parallelFor(images.size(), [&](const size_t first, const size_t last) {
+      for (size_t i = first; i < last; i++) {
+        const auto cellIndex = i % cellsPerSheet;
+        auto& cell = contactSheets.cells[i];
+        cell = {
+          .sheet = i / cellsPerSheet,
+          .x = (cellIndex % options.columns) * cellWidth,
+          .y = (cellIndex / options.columns) * cellHeight,
+        };
+
+        const auto& image = images[i];
+        auto& sheet = contactSheets.sheets[cell.sheet];
+        for (size_t y = 0; y < image.height; y++) {
+          std::copy_n(
+            image.pixels.begin() + static_cast<ptrdiff_t>(y * image.width * 4),
+            image.width * 4,
+            sheet.pixels.begin() + static_cast<ptrdiff_t>(((cell.y + y) * sheet.width + cell.x) * 4)
+          );
+        }
+      }
+    });
+
+    return contactSheets;
+  }
+}
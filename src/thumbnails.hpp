@@ -0,0 +1,134 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <span>
+#include <vector>
+#include "codec.hpp"
+
+namespace VtfParser {
+  /**
+   * Reads part of a VTF from wherever it is stored (a file, an archive, the network, ...).
+   * Called with the offset to start reading from and a buffer to fill, and returns the number of bytes read,
+   * which is only less than the buffer size at the end of the data.
+   */
+  using RangeReader = std::function<size_t(size_t offset, std::span<std::byte> buffer)>;
+
+  /**
+   * Low resolution image of a VTF, read without loading the rest of the file.
+   */
+  struct Thumbnail {
+    /**
+     * Format of the image (almost always DXT1). NONE if the VTF has no low res image.
+     */
+    ImageFormat format;
+    /**
+     * Width of the image in pixels.
+     */
+    uint8_t width;
+    /**
+     * Height of the image in pixels.
+     */
+    uint8_t height;
+    /**
+     * Image data.
+     */
+    std::vector<std::byte> data;
+  };
+
+  /**
+   * Options for buildContactSheets().
+   */
+  struct ContactSheetOptions {
+    /**
+     * Width of each cell in pixels. Zero uses the widest image.
+     */
+    size_t cellWidth = 0;
+    /**
+     * Height of each cell in pixels. Zero uses the tallest image.
+     */
+    size_t cellHeight = 0;
+    /**
+     * Number of cells in each row of a sheet.
+     */
+    size_t columns = 64;
+    /**
+     * Maximum number of rows in each sheet. Images that do not fit start a new sheet.
+     */
+    size_t rows = 64;
+    /**
+     * Maximum number of threads to use. Zero uses one per hardware thread.
+     */
+    size_t threadCount = 0;
+  };
+
+  /**
+   * Location of an image within a set of contact sheets.
+   */
+  struct ContactSheetCell {
+    /**
+     * Index of the sheet containing the image.
+     */
+    size_t sheet;
+    /**
+     * Offset of the image's left edge, in pixels.
+     */
+    size_t x;
+    /**
+     * Offset of the image's top edge, in pixels.
+     */
+    size_t y;
+  };
+
+  /**
+   * Images packed into grids by buildContactSheets().
+   */
+  struct ContactSheets {
+    /**
+     * The packed sheets. Cells without an image are transparent black.
+     */
+    std::vector<Rgba8Image> sheets;
+    /**
+     * Where each input image was placed, in the same order as the input.
+     */
+    std::vector<ContactSheetCell> cells;
+  };
+
+  /**
+   * Reads only the header and low resolution image of a VTF.
+   * @param read Callback to read ranges of the VTF with. Called at most twice.
+   * @return The low res image.
+   */
+  [[nodiscard]] Thumbnail readThumbnail(const RangeReader& read);
+
+  /**
+   * Reads only the header and low resolution image of a VTF already in memory.
+   * @param data Binary data of the VTF.
+   * @return The low res image.
+   */
+  [[nodiscard]] Thumbnail readThumbnail(std::span<const std::byte> data);
+
+  /**
+   * Decodes many thumbnails to 8-bit RGBA in parallel.
+   * @param thumbnails
+   * @param threadCount Maximum number of threads to use. Zero uses one per hardware thread.
+   * @return Decoded images in the same order. Thumbnails with no image decode to an empty (0x0) image.
+   * @throws Errors::OutOfBoundsAccess if any thumbnail's data is smaller than its extents.
+   * @throws Errors::UnsupportedImageFormat if any thumbnail's format cannot be decoded.
+   */
+  [[nodiscard]] std::vector<Rgba8Image> decodeThumbnails(std::span<const Thumbnail> thumbnails, size_t threadCount = 0);
+
+  /**
+   * Packs images into grids of equally sized cells, spread over as many sheets as needed.
+   * @remark Images are placed in the top left of their cell, in input order.
+   * @param images Images to pack, e.g. from decodeThumbnails().
+   * @param options
+   * @return The sheets and each image's location on them.
+   * @throws Errors::InvalidArgument if an image is larger than the cell size, or the grid has no rows or columns.
+   */
+  [[nodiscard]] ContactSheets buildContactSheets(
+    std::span<const Rgba8Image> images,
+    const ContactSheetOptions& options = {}
+  );
+}
@@ -1,8 +1,10 @@
 #pragma once
 
+#include <array>
 #include <cstdint>
 #include <memory>
 #include <span>
+#include "slice-view.hpp"
 #include "file-format-objects/header.hpp"
 
 namespace VtfParser {
@@ -92,6 +94,18 @@ namespace VtfParser {
      */
     [[nodiscard]] TextureFlags getFlags() const;
 
+    /**
+     * Gets the reflectivity vector of the texture.
+     * @return Reflectivity, used by VRAD for bounced lighting.
+     */
+    [[nodiscard]] std::array<float, 3> getReflectivity() const;
+
+    /**
+     * Gets the bumpmap scale of the texture.
+     * @return Bumpmap scale.
+     */
+    [[nodiscard]] float getBumpmapScale() const;
+
     /**
      * Gets the high resolution image data.
      * @return View over the high-res data.
@@ -115,6 +129,49 @@ namespace VtfParser {
       uint16_t depth = 0
     ) const;
 
+    /**
+     * Gets the data of a single image slice at the given mipmap level, animation frame, cubemap face and depth.
+     * @param mipLevel Level of the mipmap chain.
+     * @param frame Frame of animation.
+     * @param face Face of a cubemap.
+     * @param depth Depth or Z value of a volumetric texture.
+     * @return View over the slice within the data returned by getHighResImageData().
+     */
+    [[nodiscard]] std::span<const std::byte> getImageSliceData(
+      uint8_t mipLevel = 0,
+      uint16_t frame = 0,
+      uint8_t face = 0,
+      uint16_t depth = 0
+    ) const;
+
+    /**
+     * Calls the visitor with a SliceView over an image slice, specialised for the high resolution image format.
+     * @remark Use this to write loops that are compiled once per format instead of switching on the format per pixel.
+     * @param visitor Generic callable accepting any SliceView<Format>.
+     * @param mipLevel Level of the mipmap chain.
+     * @param frame Frame of animation.
+     * @param face Face of a cubemap.
+     * @param depth Depth or Z value of a volumetric texture.
+     * @return Result of the visitor.
+     */
+    template <typename Visitor>
+    decltype(auto) visitImageSlice(
+      Visitor&& visitor,
+      const uint8_t mipLevel = 0,
+      const uint16_t frame = 0,
+      const uint8_t face = 0,
+      const uint16_t depth = 0
+    ) const {
+      const auto extent = getHighResImageExtent(mipLevel);
+      return visitSlice(
+        getHighResImageFormat(),
+        getImageSliceData(mipLevel, frame, face, depth),
+        extent.width,
+        extent.height,
+        std::forward<Visitor>(visitor)
+      );
+    }
+
     /**
      * Gets the format of the low resolution image data.
      * @remark This is almost always DXT1.
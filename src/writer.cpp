@@ -0,0 +1,80 @@
+#include "writer.hpp"
+#include <algorithm>
+#include <cstring>
+#include "errors.hpp"
+#include "file-format-objects/header.hpp"
+#include "helpers/image-size.hpp"
+#include "helpers/parse-header.hpp"
+
+namespace VtfParser {
+  using namespace Errors;
+
+  namespace {
+    constexpr uint32_t WRITTEN_MINOR_VERSION = 2;
+
+    // The written header has no resource dictionary, so it must stay below the versions that expect one
+    static_assert(WRITTEN_MINOR_VERSION >= MIN_SUPPORTED_MINOR_VERSION);
+    static_assert(WRITTEN_MINOR_VERSION < MIN_RESOURCE_INFO_MINOR_VERSION);
+
+    /**
+     * Size of the header written for 7.2, which has no resource dictionary.
+     */
+    constexpr uint32_t WRITTEN_HEADER_SIZE = sizeof(HeaderFullAligned);
+  }
+
+  std::vector<std::byte> writeVtf(const VtfWriteInfo& info) {
+    const auto expectedLowResImageDataSize = getSliceSizeBytes(
+      getFormatTraits(info.lowResImageFormat),
+      info.lowResImageWidth,
+      info.lowResImageHeight
+    );
+    if (info.lowResImageData.size() != expectedLowResImageDataSize) {
+      throw InvalidArgument("Low res image data size does not match its extents");
+    }
+
+    const auto expectedHighResImageDataSize = getImageSizeBytes(
+      {
+        .format = info.highResImageFormat,
+        .width = info.width,
+        .height = info.height,
+        .depth = info.depth,
+        .faces = getFaceCount(info.flags, info.firstFrame, WRITTEN_MINOR_VERSION),
+        .frames = info.frames,
+        .mipLevels = info.mipLevels,
+      }
+    );
+    if (info.highResImageFormat == ImageFormat::NONE || info.highResImageData.size() != expectedHighResImageDataSize) {
+      throw InvalidArgument("High res image data size does not match its extents");
+    }
+
+    HeaderFullAligned header{};
+    memcpy(header.signature.data(), FILE_ID.data(), FILE_ID.size());
+    header.version = {SUPPORTED_MAJOR_VERSION, WRITTEN_MINOR_VERSION};
+    header.headerSize = WRITTEN_HEADER_SIZE;
+    header.width = info.width;
+    header.height = info.height;
+    header.flags = info.flags;
+    header.frames = info.frames;
+    header.firstFrame = info.firstFrame;
+    header.reflectivity = info.reflectivity;
+    header.bumpmapScale = info.bumpmapScale;
+    header.highResImageFormat = info.highResImageFormat;
+    header.mipmapCount = info.mipLevels;
+    header.lowResImageFormat = info.lowResImageFormat;
+    header.lowResImageWidth = info.lowResImageWidth;
+    header.lowResImageHeight = info.lowResImageHeight;
+    header.depth = info.depth;
+
+    const auto lowResImageDataOffset = WRITTEN_HEADER_SIZE;
+    const auto highResImageDataOffset = lowResImageDataOffset + info.lowResImageData.size();
+    const auto size = highResImageDataOffset + info.highResImageData.size();
+
+    // Readers (including this library) may read a full header's worth of bytes regardless of version
+    std::vector<std::byte> data(std::max(size, sizeof(Header)));
+    memcpy(data.data(), &header, WRITTEN_HEADER_SIZE);
+    std::ranges::copy(info.lowResImageData, data.begin() + lowResImageDataOffset);
+    std::ranges::copy(info.highResImageData, data.begin() + highResImageDataOffset);
+
+    return data;
+  }
+}
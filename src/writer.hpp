@@ -0,0 +1,84 @@
+#pragma once
+
+#include <array>
+#include <cstdint>
+#include <span>
+#include <vector>
+#include "file-format-objects/enums.hpp"
+
+namespace VtfParser {
+  /**
+   * Contents of a VTF to be written by writeVtf().
+   */
+  struct VtfWriteInfo {
+    /**
+     * Format of the high resolution image data.
+     */
+    ImageFormat highResImageFormat;
+    /**
+     * Width of the largest mipmap in pixels.
+     */
+    uint16_t width;
+    /**
+     * Height of the largest mipmap in pixels.
+     */
+    uint16_t height;
+    /**
+     * Depth of the largest mipmap in pixels. 1 for a 2D texture.
+     */
+    uint16_t depth = 1;
+    /**
+     * VTF flags.
+     */
+    TextureFlags flags = TextureFlags::NONE;
+    /**
+     * Number of frames of animation.
+     */
+    uint16_t frames = 1;
+    /**
+     * First frame in animation. 0xffff gives environment maps 7 faces instead of 6.
+     */
+    uint16_t firstFrame = 0;
+    /**
+     * Number of MIP levels.
+     */
+    uint8_t mipLevels = 1;
+    /**
+     * Reflectivity vector.
+     */
+    std::array<float, 3> reflectivity = {};
+    /**
+     * Bumpmap scale.
+     */
+    float bumpmapScale = 1.0f;
+    /**
+     * Format of the low resolution image data.
+     */
+    ImageFormat lowResImageFormat = ImageFormat::NONE;
+    /**
+     * Width of the low resolution image in pixels.
+     */
+    uint8_t lowResImageWidth = 0;
+    /**
+     * Height of the low resolution image in pixels.
+     */
+    uint8_t lowResImageHeight = 0;
+    /**
+     * Low resolution image data.
+     */
+    std::span<const std::byte> lowResImageData = {};
+    /**
+     * High resolution image data, laid out as returned by Vtf::getHighResImageData()
+     * (smallest mip level first, then frames, faces and depth slices).
+     */
+    std::span<const std::byte> highResImageData;
+  };
+
+  /**
+   * Writes a VTF (version 7.2) from its contents.
+   * @param info
+   * @return Binary data of the VTF.
+   * @throws Errors::InvalidArgument if the image data does not match the size given by the other fields.
+   */
+  [[nodiscard]] std::vector<std::byte> writeVtf(const VtfWriteInfo& info);
+}
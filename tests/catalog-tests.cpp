@@ -0,0 +1,116 @@
+#include "test-helpers.hpp"
+#include <algorithm>
+#include <cstring>
+
+using namespace VtfParser;
+using namespace VtfParser::Errors;
+using namespace VtfParser::Tests;
+
+namespace {
+  void catalogFindsEntries() {
+    const auto first = makeVtf(16, 8, ImageFormat::BGRA8888, 5, TextureFlags::CLAMPS);
+    const auto second = makeVtf(4, 4, ImageFormat::RGBA16161616F);
+
+    CatalogBuilder builder;
+    builder.add("materials/first.vtf", first);
+    builder.add("materials/second.vtf", second);
+    const auto data = builder.build();
+    const Catalog catalog(data);
+
+    CHECK(catalog.getEntries().size() == 2);
+    CHECK(std::ranges::is_sorted(catalog.getEntries(), {}, &CatalogEntry::pathHash));
+
+    const auto* entry = catalog.find("materials/first.vtf");
+    CHECK(entry != nullptr);
+    CHECK(catalog.getPath(*entry) == "materials/first.vtf");
+    CHECK(entry->pathHash == Catalog::hashPath("materials/first.vtf"));
+    CHECK(entry->version[0] == 7 && entry->version[1] == 2);
+    CHECK(entry->flags == TextureFlags::CLAMPS);
+    CHECK(entry->highResImageFormat == ImageFormat::BGRA8888);
+    CHECK(entry->lowResImageFormat == ImageFormat::DXT1);
+    CHECK(entry->width == 16 && entry->height == 8 && entry->depth == 1);
+    CHECK(entry->frames == 1 && entry->faces == 1 && entry->mipLevels == 5);
+    CHECK(entry->lowResImageWidth == 16 && entry->lowResImageHeight == 16);
+
+    const auto* secondEntry = catalog.find("materials/second.vtf");
+    CHECK(secondEntry != nullptr && catalog.getPath(*secondEntry) == "materials/second.vtf");
+    CHECK(secondEntry->highResImageFormat == ImageFormat::RGBA16161616F);
+
+    CHECK(catalog.find("materials/third.vtf") == nullptr);
+    CHECK(catalog.find("") == nullptr);
+  }
+
+  void readdingAPathReplacesItsEntry() {
+    CatalogBuilder builder;
+    builder.add("a.vtf", makeVtf(16, 16, ImageFormat::BGRA8888));
+    builder.add("a.vtf", makeVtf(32, 8, ImageFormat::RGB888));
+    const auto data = builder.build();
+    const Catalog catalog(data);
+
+    CHECK(catalog.getEntries().size() == 1);
+    const auto* entry = catalog.find("a.vtf");
+    CHECK(entry != nullptr);
+    CHECK(entry->width == 32 && entry->height == 8);
+    CHECK(entry->highResImageFormat == ImageFormat::RGB888);
+  }
+
+  void offsetsMatchTheVtf() {
+    const auto vtfData = makeVtf(32, 32, ImageFormat::DXT5, 6);
+    const Vtf vtf(vtfData);
+
+    CatalogBuilder builder;
+    builder.add("texture.vtf", vtfData);
+    const auto data = builder.build();
+    const Catalog catalog(data);
+    const auto& entry = *catalog.find("texture.vtf");
+
+    const auto highResImageData = vtf.getHighResImageData();
+    CHECK(vtfData.data() + entry.highResImageDataOffset == highResImageData.data());
+    CHECK(entry.highResImageDataSize == highResImageData.size());
+
+    const auto lowResImageData = vtf.getLowResImageData();
+    CHECK(vtfData.data() + entry.lowResImageDataOffset == lowResImageData.data());
+    CHECK(entry.lowResImageDataSize == lowResImageData.size());
+  }
+
+  void emptyCatalogsAreValid() {
+    const auto data = CatalogBuilder().build();
+    CHECK(data.size() == sizeof(CatalogHeader));
+
+    const Catalog catalog(data);
+    CHECK(catalog.getEntries().empty());
+    CHECK(catalog.find("a.vtf") == nullptr);
+  }
+
+  void invalidCatalogsThrow() {
+    CatalogBuilder builder;
+    builder.add("a.vtf", makeVtf(4, 4, ImageFormat::RGBA8888));
+    const auto data = builder.build();
+
+    CHECK_THROWS(Catalog(std::span(data.data(), sizeof(CatalogHeader) - 1)), OutOfBoundsAccess);
+    CHECK_THROWS(Catalog(std::span(data.data(), sizeof(CatalogHeader) + sizeof(CatalogEntry) - 1)), OutOfBoundsAccess);
+    CHECK_THROWS(Catalog(std::span(data.data(), data.size() - 1)), OutOfBoundsAccess);
+
+    auto badSignature = data;
+    badSignature[3] = std::byte{'X'};
+    CHECK_THROWS(Catalog{badSignature}, InvalidHeader);
+
+    auto badVersion = data;
+    const uint32_t version = CatalogHeader::VERSION + 1;
+    memcpy(badVersion.data() + offsetof(CatalogHeader, version), &version, sizeof(version));
+    CHECK_THROWS(Catalog{badVersion}, UnsupportedVersion);
+
+    // Heap allocations are aligned, so shift the copy by one byte
+    std::vector<std::byte> misaligned(data.size() + 1);
+    std::ranges::copy(data, misaligned.begin() + 1);
+    CHECK_THROWS(Catalog(std::span(misaligned).subspan(1)), InvalidArgument);
+  }
+}
+
+int main() {
+  catalogFindsEntries();
+  readdingAPathReplacesItsEntry();
+  offsetsMatchTheVtf();
+  emptyCatalogsAreValid();
+  invalidCatalogsThrow();
+}
@@ -0,0 +1,228 @@
+#include "test-helpers.hpp"
+#include <array>
+#include <cmath>
+
+using namespace VtfParser;
+
+namespace {
+  bool isNear(const float actual, const float expected) {
+    return std::abs(actual - expected) < 1e-3f;
+  }
+
+  std::vector<std::byte> toBytes(const std::initializer_list<uint8_t> values) {
+    std::vector<std::byte> bytes;
+    for (const auto value : values) {
+      bytes.push_back(static_cast<std::byte>(value));
+    }
+    return bytes;
+  }
+
+  /**
+   * What decodeSlice() should return for a channel after the pixel went through a format.
+   */
+  float getExpectedChannel(const ImageFormat format, const float* pixel, const size_t channel) {
+    switch (format) {
+      case ImageFormat::RGB888:
+      case ImageFormat::BGR888:
+        return channel == 3 ? 1.0f : pixel[channel];
+      case ImageFormat::I8:
+        return channel == 3 ? 1.0f : pixel[0];
+      case ImageFormat::A8:
+        return channel == 3 ? pixel[3] : 0.0f;
+      default:
+        return pixel[channel];
+    }
+  }
+
+  void encodedSlicesRoundTrip() {
+    constexpr std::array formats = {
+      ImageFormat::RGBA8888,
+      ImageFormat::BGRA8888,
+      ImageFormat::ABGR8888,
+      ImageFormat::ARGB8888,
+      ImageFormat::RGB888,
+      ImageFormat::BGR888,
+      ImageFormat::I8,
+      ImageFormat::A8,
+      ImageFormat::RGBA16161616F,
+    };
+
+    // Multiples of 1/255 survive 8-bit formats exactly
+    RgbaImage image = {.width = 8, .height = 4, .pixels = {}};
+    image.pixels.resize(8 * 4 * 4);
+    for (size_t i = 0; i < image.pixels.size(); i++) {
+      image.pixels[i] = static_cast<float>(i * 13 % 256) / 255.0f;
+    }
+
+    for (const auto format : formats) {
+      CHECK(canEncode(format));
+
+      const auto encoded = encodeSlice(format, image);
+      const auto data = writeVtf(
+        {
+          .highResImageFormat = format,
+          .width = 8,
+          .height = 4,
+          .highResImageData = encoded,
+        }
+      );
+      const Vtf vtf(data);
+      CHECK(vtf.getHighResImageFormat() == format);
+
+      const auto decoded = decodeSlice(format, vtf.getImageSliceData(0), 8, 4);
+      CHECK(decoded.pixels.size() == image.pixels.size());
+      for (size_t i = 0; i < decoded.pixels.size(); i++) {
+        const auto* pixel = image.pixels.data() + i / 4 * 4;
+        CHECK(isNear(decoded.pixels[i], getExpectedChannel(format, pixel, i % 4)));
+      }
+    }
+  }
+
+  void unsupportedFormatsCannotBeEncoded() {
+    CHECK(!canEncode(ImageFormat::DXT1));
+    CHECK(!canEncode(ImageFormat::P8));
+
+    const RgbaImage image = {.width = 1, .height = 1, .pixels = {0.0f, 0.0f, 0.0f, 0.0f}};
+    CHECK_THROWS(encodeSlice(ImageFormat::DXT5, image), Errors::UnsupportedImageFormat);
+  }
+
+  void eightBitChannelsAreRoundedAndOrdered() {
+    const RgbaImage image = {.width = 1, .height = 1, .pixels = {1.0f, 0.5f, -1.0f, 2.0f}};
+
+    CHECK(encodeSlice(ImageFormat::BGRA8888, image) == toBytes({0, 128, 255, 255}));
+    CHECK(encodeSlice(ImageFormat::ARGB8888, image) == toBytes({255, 255, 128, 0}));
+
+    const RgbaImage nonFinite = {.width = 1, .height = 1, .pixels = {NAN, INFINITY, -INFINITY, NAN}};
+    CHECK(encodeSlice(ImageFormat::RGBA8888, nonFinite) == toBytes({0, 255, 0, 0}));
+  }
+
+  /**
+   * DXT colour block with red, blue and the two interpolated colours in the first row, and red everywhere else.
+   */
+  std::vector<std::byte> makeFourColourBlock() {
+    return toBytes({0x00, 0xf8, 0x1f, 0x00, 0xe4, 0x00, 0x00, 0x00});
+  }
+
+  void dxt1BlockDecodes() {
+    const auto block = makeFourColourBlock();
+    const auto image = decodeSlice(ImageFormat::DXT1, block, 4, 4);
+
+    constexpr std::array<std::array<float, 4>, 4> expected = {{
+      {1.0f, 0.0f, 0.0f, 1.0f},
+      {0.0f, 0.0f, 1.0f, 1.0f},
+      {2.0f / 3.0f, 0.0f, 1.0f / 3.0f, 1.0f},
+      {1.0f / 3.0f, 0.0f, 2.0f / 3.0f, 1.0f},
+    }};
+    for (size_t texel = 0; texel < 4; texel++) {
+      for (size_t channel = 0; channel < 4; channel++) {
+        CHECK(isNear(image.pixels[texel * 4 + channel], expected[texel][channel]));
+      }
+    }
+    CHECK(isNear(image.pixels[15 * 4], 1.0f));
+
+    const auto image8 = decodeSliceRgba8(ImageFormat::DXT1, block, 4, 4);
+    CHECK(image8.pixels[0] == 255 && image8.pixels[1] == 0 && image8.pixels[2] == 0 && image8.pixels[3] == 255);
+    CHECK(image8.pixels[8] == 170 && image8.pixels[9] == 0 && image8.pixels[10] == 85 && image8.pixels[11] == 255);
+  }
+
+  void dxt1TransparentBlockDecodes() {
+    // colour0 <= colour1 switches to three colours plus transparent black
+    const auto block = toBytes({0x1f, 0x00, 0x00, 0xf8, 0xe4, 0x00, 0x00, 0x00});
+    const auto image = decodeSlice(ImageFormat::DXT1, block, 4, 4);
+    const auto image8 = decodeSliceRgba8(ImageFormat::DXT1, block, 4, 4);
+
+    CHECK(isNear(image.pixels[8], 0.5f) && isNear(image.pixels[10], 0.5f) && isNear(image.pixels[11], 1.0f));
+    for (size_t channel = 0; channel < 4; channel++) {
+      CHECK(image.pixels[12 + channel] == 0.0f);
+      CHECK(image8.pixels[12 + channel] == 0);
+    }
+  }
+
+  void dxt3BlockDecodes() {
+    // Explicit 4-bit alpha: 15, 0, 8 for the first three texels
+    auto block = toBytes({0x0f, 0x08, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00});
+    const auto colour = makeFourColourBlock();
+    block.insert(block.end(), colour.begin(), colour.end());
+
+    const auto image = decodeSlice(ImageFormat::DXT3, block, 4, 4);
+    CHECK(isNear(image.pixels[3], 1.0f));
+    CHECK(isNear(image.pixels[7], 0.0f));
+    CHECK(isNear(image.pixels[11], 8.0f / 15.0f));
+    CHECK(isNear(image.pixels[4 + 2], 1.0f));
+  }
+
+  void dxt5BlockDecodes() {
+    // alpha0 > alpha1 selects six interpolated alphas; indices 0, 1, 2 for the first three texels
+    auto block = toBytes({0xff, 0x00, 0x88, 0x00, 0x00, 0x00, 0x00, 0x00});
+    const auto colour = makeFourColourBlock();
+    block.insert(block.end(), colour.begin(), colour.end());
+
+    const auto image = decodeSlice(ImageFormat::DXT5, block, 4, 4);
+    CHECK(isNear(image.pixels[3], 1.0f));
+    CHECK(isNear(image.pixels[7], 0.0f));
+    CHECK(isNear(image.pixels[11], 6.0f / 7.0f));
+    CHECK(isNear(image.pixels[12 + 2], 2.0f / 3.0f));
+  }
+
+  void halfFloatsDecode() {
+    // 1, -2, 1/3 (rounded), 65504, smallest subnormal, infinity, 0.5 and negative zero
+    const auto data = toBytes(
+      {0x00, 0x3c, 0x00, 0xc0, 0x55, 0x35, 0xff, 0x7b, 0x01, 0x00, 0x00, 0x7c, 0x00, 0x38, 0x00, 0x80}
+    );
+    const auto image = decodeSlice(ImageFormat::RGBA16161616F, data, 2, 1);
+
+    CHECK(image.pixels[0] == 1.0f);
+    CHECK(image.pixels[1] == -2.0f);
+    CHECK(image.pixels[2] == 0.333251953125f);
+    CHECK(image.pixels[3] == 65504.0f);
+    CHECK(image.pixels[4] == std::ldexp(1.0f, -24));
+    CHECK(std::isinf(image.pixels[5]) && image.pixels[5] > 0.0f);
+    CHECK(image.pixels[6] == 0.5f);
+    CHECK(image.pixels[7] == 0.0f && std::signbit(image.pixels[7]));
+  }
+
+  void halfFloatsEncode() {
+    const RgbaImage image = {
+      .width = 2,
+      .height = 1,
+      .pixels = {1.0f, -2.0f, 65504.0f, 1e6f, std::ldexp(1.0f, -24), 1e-10f, 0.5f, -0.0f},
+    };
+
+    CHECK(
+      encodeSlice(ImageFormat::RGBA16161616F, image)
+      == toBytes({0x00, 0x3c, 0x00, 0xc0, 0xff, 0x7b, 0x00, 0x7c, 0x01, 0x00, 0x00, 0x00, 0x00, 0x38, 0x00, 0x80})
+    );
+  }
+
+  void packedFormatsDecode() {
+    // The first channel of packed formats is stored in the least significant bits
+    const auto rgb565 = decodeSlice(ImageFormat::RGB565, toBytes({0x1f, 0x00, 0xe0, 0x07}), 2, 1);
+    CHECK(rgb565.pixels == (std::vector{1.0f, 0.0f, 0.0f, 1.0f, 0.0f, 1.0f, 0.0f, 1.0f}));
+
+    const auto bgr565 = decodeSlice(ImageFormat::BGR565, toBytes({0x1f, 0x00, 0x00, 0xf8}), 2, 1);
+    CHECK(bgr565.pixels == (std::vector{0.0f, 0.0f, 1.0f, 1.0f, 1.0f, 0.0f, 0.0f, 1.0f}));
+
+    const auto bgra5551 = decodeSlice(ImageFormat::BGRA5551, toBytes({0x00, 0x80, 0x00, 0x7c}), 2, 1);
+    CHECK(bgra5551.pixels == (std::vector{0.0f, 0.0f, 0.0f, 1.0f, 1.0f, 0.0f, 0.0f, 0.0f}));
+
+    const auto bgra4444 = decodeSlice(ImageFormat::BGRA4444, toBytes({0x00, 0xf0, 0x08, 0x0f}), 2, 1);
+    CHECK(bgra4444.pixels[3] == 1.0f);
+    CHECK(bgra4444.pixels[0] == 0.0f && bgra4444.pixels[2] == 0.0f);
+    CHECK(bgra4444.pixels[4] == 1.0f);
+    CHECK(isNear(bgra4444.pixels[6], 8.0f / 15.0f));
+    CHECK(bgra4444.pixels[7] == 0.0f);
+  }
+}
+
+int main() {
+  encodedSlicesRoundTrip();
+  unsupportedFormatsCannotBeEncoded();
+  eightBitChannelsAreRoundedAndOrdered();
+  dxt1BlockDecodes();
+  dxt1TransparentBlockDecodes();
+  dxt3BlockDecodes();
+  dxt5BlockDecodes();
+  halfFloatsDecode();
+  halfFloatsEncode();
+  packedFormatsDecode();
+}
@@ -0,0 +1,255 @@
+#include "test-helpers.hpp"
+#include <cmath>
+#include <limits>
+
+using namespace VtfParser;
+using namespace VtfParser::Errors;
+
+namespace {
+  float applySrgbTransfer(const float value) {
+    return value <= 0.0031308f ? value * 12.92f : 1.055f * std::pow(value, 1.0f / 2.4f) - 0.055f;
+  }
+
+  float removeSrgbTransfer(const float value) {
+    return value <= 0.04045f ? value / 12.92f : std::pow((value + 0.055f) / 1.055f, 2.4f);
+  }
+
+  /**
+   * Builds a 4x3 image whose channels all differ, so misplaced pixels show up.
+   */
+  Rgba8Image makeRgba8Image() {
+    Rgba8Image image = {.width = 4, .height = 3, .pixels = {}};
+    for (size_t i = 0; i < 4 * 3 * 4; i++) {
+      image.pixels.push_back(static_cast<uint8_t>(i * 5));
+    }
+    return image;
+  }
+
+  /**
+   * Builds a single pixel VTF with every channel set to the same byte.
+   */
+  std::vector<std::byte> makeFlatVtf(const ImageFormat format, const TextureFlags flags, const std::byte value) {
+    const std::vector highResImageData(getSliceSizeBytes(getFormatTraits(format), 1, 1), value);
+    return writeVtf(
+      {
+        .highResImageFormat = format,
+        .width = 1,
+        .height = 1,
+        .flags = flags,
+        .highResImageData = highResImageData,
+      }
+    );
+  }
+
+  void colourSpaceFollowsFlags() {
+    CHECK(getColourSpace(TextureFlags::NONE) == ColourSpace::LINEAR);
+    CHECK(getColourSpace(TextureFlags::CLAMPS) == ColourSpace::LINEAR);
+    CHECK(getColourSpace(TextureFlags::SRGB) == ColourSpace::SRGB);
+    CHECK(getColourSpace(TextureFlags::PRE_SRGB) == ColourSpace::SRGB);
+    CHECK(getColourSpace(TextureFlags::SRGB | TextureFlags::PRE_SRGB | TextureFlags::CLAMPS) == ColourSpace::SRGB);
+  }
+
+  void srgbTablesMatchTransferFunction() {
+    for (size_t i = 0; i < 256; i++) {
+      const auto value = static_cast<uint8_t>(i);
+      CHECK(std::abs(srgbToLinear(value) - removeSrgbTransfer(static_cast<float>(i) / 255.0f)) < 1e-6f);
+      CHECK(linearToSrgb(srgbToLinear(value)) == value);
+    }
+
+    // Within one step of the exactly rounded transfer function, including in the steep region near black
+    for (size_t i = 0; i <= 100000; i++) {
+      const auto value = static_cast<float>(i) / 100000.0f;
+      const auto exact = static_cast<int>(applySrgbTransfer(value) * 255.0f + 0.5f);
+      CHECK(std::abs(static_cast<int>(linearToSrgb(value)) - exact) <= 1);
+    }
+
+    CHECK(linearToSrgb(-1.0f) == 0);
+    CHECK(linearToSrgb(2.0f) == 255);
+  }
+
+  void regionsAreConverted() {
+    const auto image = makeRgba8Image();
+    const ImageRegion region = {.x = 1, .y = 1, .width = 2, .height = 2};
+
+    for (const auto colourSpace : {ColourSpace::SRGB, ColourSpace::LINEAR}) {
+      const auto linear = toLinear(image, colourSpace, region);
+      CHECK(linear.width == 2 && linear.height == 2 && linear.pixels.size() == 2 * 2 * 4);
+
+      for (size_t y = 0; y < 2; y++) {
+        for (size_t i = 0; i < 2 * 4; i++) {
+          const auto source = image.pixels[((y + 1) * 4 + 1) * 4 + i];
+          const bool isColour = i % 4 != 3;
+          const auto expected = isColour && colourSpace == ColourSpace::SRGB
+            ? srgbToLinear(source)
+            : static_cast<float>(source) / 255.0f;
+          CHECK(std::abs(linear.pixels[y * 2 * 4 + i] - expected) < 1e-6f);
+        }
+      }
+
+      // Converting the whole linear image back recovers the original region exactly
+      const auto converted = fromLinear(linear, colourSpace);
+      const auto convertedRegion = fromLinear(toLinear(image, colourSpace), colourSpace, region);
+      CHECK(converted.pixels == convertedRegion.pixels);
+      for (size_t y = 0; y < 2; y++) {
+        for (size_t i = 0; i < 2 * 4; i++) {
+          CHECK(converted.pixels[y * 2 * 4 + i] == image.pixels[((y + 1) * 4 + 1) * 4 + i]);
+        }
+      }
+    }
+
+    const auto whole = toLinear(image, ColourSpace::LINEAR);
+    CHECK(whole.width == 4 && whole.height == 3);
+    CHECK(toLinear(image, ColourSpace::LINEAR, {.x = 4, .y = 3, .width = 0, .height = 0}).pixels.empty());
+  }
+
+  void regionsOutsideTheImageThrow() {
+    const auto image = makeRgba8Image();
+    const auto linear = toLinear(image, ColourSpace::LINEAR);
+
+    CHECK_THROWS(toLinear(image, ColourSpace::SRGB, {.x = 3, .y = 0, .width = 2, .height = 1}), OutOfBoundsAccess);
+    CHECK_THROWS(toLinear(image, ColourSpace::SRGB, {.x = 0, .y = 2, .width = 1, .height = 2}), OutOfBoundsAccess);
+    CHECK_THROWS(
+      toLinear(image, ColourSpace::SRGB, {.x = 5, .y = 0, .width = 0, .height = 0}),
+      OutOfBoundsAccess
+    );
+    // Sizes which would wrap around if added to the offset
+    CHECK_THROWS(
+      fromLinear(linear, ColourSpace::SRGB, {.x = 1, .y = 0, .width = SIZE_MAX, .height = 1}),
+      OutOfBoundsAccess
+    );
+  }
+
+  void decodeSliceLinearFollowsColourSpace() {
+    // Vtf does not own its data, so each buffer is kept alive alongside it
+    const auto linearData = makeFlatVtf(ImageFormat::RGBA8888, TextureFlags::NONE, std::byte{128});
+    const Vtf linear(linearData);
+    CHECK(std::abs(decodeSliceLinear(linear).pixels[0] - 128.0f / 255.0f) < 1e-6f);
+
+    for (const auto flags : {TextureFlags::SRGB, TextureFlags::PRE_SRGB}) {
+      const auto srgbData = makeFlatVtf(ImageFormat::RGBA8888, flags, std::byte{128});
+      const Vtf srgb(srgbData);
+      const auto image = decodeSliceLinear(srgb);
+      CHECK(image.pixels[0] == srgbToLinear(128));
+      CHECK(std::abs(image.pixels[3] - 128.0f / 255.0f) < 1e-6f);
+    }
+
+    // 0x3838 is 0.5273 as a half float, which is left alone despite the flag
+    const auto highDynamicRangeData = makeFlatVtf(ImageFormat::RGBA16161616F, TextureFlags::SRGB, std::byte{0x38});
+    const Vtf highDynamicRange(highDynamicRangeData);
+    CHECK(decodeSliceLinear(highDynamicRange).pixels[0] == 0.52734375f);
+  }
+
+  void floatSrgbMatchesTransferFunction() {
+    RgbaImage image = {.width = 1024, .height = 1, .pixels = {}};
+    for (size_t i = 0; i < 1024 * 4; i++) {
+      image.pixels.push_back(static_cast<float>(i) / 4095.0f);
+    }
+    image.pixels[0] = -1.0f;
+    image.pixels[1] = 2.0f;
+
+    const auto converted = toSrgb(image);
+
+    CHECK(converted.width == 1024 && converted.height == 1);
+    CHECK(converted.pixels[0] == 0.0f);
+    CHECK(std::abs(converted.pixels[1] - 1.0f) < 1e-6f);
+    for (size_t i = 2; i < converted.pixels.size(); i++) {
+      const auto expected = i % 4 == 3 ? image.pixels[i] : applySrgbTransfer(image.pixels[i]);
+      CHECK(std::abs(converted.pixels[i] - expected) < 1e-5f);
+    }
+  }
+
+  void nonFiniteValuesAreClamped() {
+    constexpr auto nan = std::numeric_limits<float>::quiet_NaN();
+    constexpr auto infinity = std::numeric_limits<float>::infinity();
+
+    CHECK(linearToSrgb(nan) == 0);
+    CHECK(linearToSrgb(infinity) == 255);
+    CHECK(linearToSrgb(-infinity) == 0);
+
+    const RgbaImage image = {.width = 1, .height = 1, .pixels = {nan, infinity, -infinity, nan}};
+    for (const auto colourSpace : {ColourSpace::SRGB, ColourSpace::LINEAR}) {
+      const auto converted = fromLinear(image, colourSpace);
+      CHECK(converted.pixels == (std::vector<uint8_t>{0, 255, 0, 0}));
+    }
+
+    const auto srgb = toSrgb(image);
+    CHECK(srgb.pixels[0] == 0.0f);
+    CHECK(std::abs(srgb.pixels[1] - 1.0f) < 1e-6f);
+    CHECK(srgb.pixels[2] == 0.0f);
+    CHECK(std::isnan(srgb.pixels[3]));
+  }
+
+  /**
+   * Builds a 2x1 sRGB flagged VTF with a black and a white pixel, which average to 0.5 in linear space.
+   */
+  std::vector<std::byte> makeBlackAndWhiteVtf() {
+    const std::vector<std::byte> highResImageData = {
+      std::byte{0}, std::byte{0}, std::byte{0}, std::byte{255},
+      std::byte{255}, std::byte{255}, std::byte{255}, std::byte{255},
+    };
+    return writeVtf(
+      {
+        .highResImageFormat = ImageFormat::RGBA8888,
+        .width = 2,
+        .height = 1,
+        .flags = TextureFlags::SRGB,
+        .highResImageData = highResImageData,
+      }
+    );
+  }
+
+  void resampledHighDynamicRangeOutputIsLinear() {
+    const auto data = makeBlackAndWhiteVtf();
+    const Vtf source(data);
+
+    for (const bool linearise : {true, false}) {
+      const auto resampledData = resampleVtf(
+        source,
+        1,
+        1,
+        {.format = ImageFormat::RGBA16161616F, .linearise = linearise}
+      );
+      const Vtf resampled(resampledData);
+      const auto image = decodeSliceLinear(resampled);
+
+      // 0.5 has no exact 8-bit sRGB value, so this also shows the output was not quantised
+      CHECK(std::abs(image.pixels[0] - 0.5f) < 1e-3f);
+      CHECK(image.pixels[3] == 1.0f);
+    }
+  }
+
+  void resampledHighDynamicRangeSourceIsGammaEncoded() {
+    const RgbaImage grey = {.width = 2, .height = 2, .pixels = std::vector(2 * 2 * 4, 0.5f)};
+    const auto highResImageData = encodeSlice(ImageFormat::RGBA16161616F, grey);
+    const auto data = writeVtf(
+      {
+        .highResImageFormat = ImageFormat::RGBA16161616F,
+        .width = 2,
+        .height = 2,
+        .flags = TextureFlags::SRGB,
+        .highResImageData = highResImageData,
+      }
+    );
+    const Vtf source(data);
+
+    const auto resampledData = resampleVtf(source, 1, 1, {.format = ImageFormat::BGRA8888});
+    const Vtf resampled(resampledData);
+    const auto image = decodeSliceLinear(resampled);
+
+    // Within one 8-bit sRGB step of the linear source
+    CHECK(std::abs(image.pixels[0] - 0.5f) < 5e-3f);
+    CHECK(resampled.getImageSliceData(0)[0] == std::byte{linearToSrgb(0.5f)});
+  }
+}
+
+int main() {
+  colourSpaceFollowsFlags();
+  srgbTablesMatchTransferFunction();
+  regionsAreConverted();
+  regionsOutsideTheImageThrow();
+  decodeSliceLinearFollowsColourSpace();
+  floatSrgbMatchesTransferFunction();
+  nonFiniteValuesAreClamped();
+  resampledHighDynamicRangeOutputIsLinear();
+  resampledHighDynamicRangeSourceIsGammaEncoded();
+}
@@ -0,0 +1,164 @@
+#include "test-helpers.hpp"
+#include <string>
+#include <thread>
+
+using namespace VtfParser;
+using namespace VtfParser::Errors;
+using namespace VtfParser::Tests;
+
+namespace {
+  /**
+   * Counters are process wide, so checks compare against a snapshot taken before the work.
+   */
+  Instrumentation::Snapshot getDifference(const Instrumentation::Snapshot& before) {
+    auto snapshot = Instrumentation::getSnapshot();
+    snapshot.vtfConstructions -= before.vtfConstructions;
+    snapshot.parseNanoseconds -= before.parseNanoseconds;
+    snapshot.bytesTouched -= before.bytesTouched;
+    snapshot.cacheHits -= before.cacheHits;
+    snapshot.cacheMisses -= before.cacheMisses;
+    for (size_t i = 0; i < snapshot.formats.size(); i++) {
+      snapshot.formats[i].operations -= before.formats[i].operations;
+      snapshot.formats[i].bytes -= before.formats[i].bytes;
+      snapshot.formats[i].nanoseconds -= before.formats[i].nanoseconds;
+    }
+    for (size_t i = 0; i < snapshot.errors.size(); i++) {
+      snapshot.errors[i] -= before.errors[i];
+    }
+    return snapshot;
+  }
+
+  void constructionsAndFormatsAreCounted() {
+    const auto data = makeVtf(16, 16, ImageFormat::BGRA8888);
+    const auto before = Instrumentation::getSnapshot();
+
+    const Vtf first(data);
+    const Vtf second(data);
+    static_cast<void>(decodeSlice(ImageFormat::BGRA8888, first.getImageSliceData(0), 16, 16));
+
+    const auto difference = getDifference(before);
+    CHECK(difference.vtfConstructions == 2);
+    // Two 7.2 headers (80 bytes each) and one decoded slice
+    CHECK(difference.bytesTouched == 2 * 80 + 16 * 16 * 4);
+
+    const auto& format = difference.getFormat(ImageFormat::BGRA8888);
+    CHECK(format.operations == 1);
+    CHECK(format.bytes == 16 * 16 * 4);
+    CHECK(difference.getFormat(ImageFormat::DXT1).operations == 0);
+  }
+
+  void errorsAreCountedWhereverTheyAreThrown() {
+    const auto before = Instrumentation::getSnapshot();
+
+    const RgbaImage image = {.width = 1, .height = 1, .pixels = {0.0f, 0.0f, 0.0f, 0.0f}};
+    const std::vector<std::byte> shortData(16);
+    CHECK_THROWS(Vtf(shortData), OutOfBoundsAccess);
+    CHECK_THROWS(decodeSlice(ImageFormat::P8, shortData, 1, 1), UnsupportedImageFormat);
+    CHECK_THROWS(encodeSlice(ImageFormat::DXT1, image), UnsupportedImageFormat);
+    CHECK_THROWS(resample(image, 0, 1), InvalidArgument);
+    const Rgba8Image image8 = {.width = 1, .height = 1, .pixels = {0, 0, 0, 0}};
+    CHECK_THROWS(toLinear(image8, ColourSpace::SRGB, {.x = 1, .y = 1, .width = 1, .height = 1}), OutOfBoundsAccess);
+
+    const auto difference = getDifference(before);
+    CHECK(difference.getErrors(Reason::OutOfBoundsAccess) == 2);
+    CHECK(difference.getErrors(Reason::UnsupportedImageFormat) == 2);
+    CHECK(difference.getErrors(Reason::InvalidArgument) == 1);
+    CHECK(difference.getErrors(Reason::InvalidHeader) == 0);
+    CHECK(difference.vtfConstructions == 0);
+  }
+
+  void cacheLookupsAreCounted() {
+    const auto data = makeVtf(4, 4, ImageFormat::RGBA8888);
+    CatalogBuilder builder;
+    builder.add("materials/a.vtf", data);
+    const auto catalogData = builder.build();
+    const Catalog catalog(catalogData);
+
+    const auto before = Instrumentation::getSnapshot();
+    CHECK(catalog.find("materials/a.vtf") != nullptr);
+    CHECK(catalog.find("materials/b.vtf") == nullptr);
+
+    const auto difference = getDifference(before);
+    CHECK(difference.cacheHits == 1);
+    CHECK(difference.cacheMisses == 1);
+  }
+
+  void exitedThreadsAreKept() {
+    const auto data = makeVtf(16, 16, ImageFormat::BGRA8888);
+    const auto before = Instrumentation::getSnapshot();
+
+    std::thread thread([&data] {
+      for (size_t i = 0; i < 3; i++) {
+        const Vtf vtf(data);
+      }
+      CHECK_THROWS(Vtf(std::span(data.data(), 16)), OutOfBoundsAccess);
+    });
+    thread.join();
+
+    const auto difference = getDifference(before);
+    CHECK(difference.vtfConstructions == 3);
+    CHECK(difference.getErrors(Reason::OutOfBoundsAccess) == 1);
+  }
+
+  Instrumentation::Snapshot makeSnapshot() {
+    Instrumentation::Snapshot snapshot{};
+    snapshot.vtfConstructions = 1;
+    snapshot.parseNanoseconds = 2;
+    snapshot.bytesTouched = 3;
+    snapshot.cacheHits = 4;
+    snapshot.cacheMisses = 5;
+    snapshot.formats[static_cast<size_t>(ImageFormat::DXT1) + 1] = {.operations = 6, .bytes = 7, .nanoseconds = 8};
+    snapshot.errors[static_cast<size_t>(Reason::InvalidHeader)] = 9;
+    return snapshot;
+  }
+
+  void prometheusTextIsFormatted() {
+    CHECK(
+      Instrumentation::toPrometheusText(makeSnapshot()) == std::string(
+        "# TYPE vtfparser_vtf_constructions_total counter\n"
+        "vtfparser_vtf_constructions_total 1\n"
+        "# TYPE vtfparser_parse_nanoseconds_total counter\n"
+        "vtfparser_parse_nanoseconds_total 2\n"
+        "# TYPE vtfparser_bytes_touched_total counter\n"
+        "vtfparser_bytes_touched_total 3\n"
+        "# TYPE vtfparser_cache_lookups_total counter\n"
+        "vtfparser_cache_lookups_total{result=\"hit\"} 4\n"
+        "vtfparser_cache_lookups_total{result=\"miss\"} 5\n"
+        "# TYPE vtfparser_format_operations_total counter\n"
+        "vtfparser_format_operations_total{format=\"DXT1\"} 6\n"
+        "# TYPE vtfparser_format_bytes_total counter\n"
+        "vtfparser_format_bytes_total{format=\"DXT1\"} 7\n"
+        "# TYPE vtfparser_format_nanoseconds_total counter\n"
+        "vtfparser_format_nanoseconds_total{format=\"DXT1\"} 8\n"
+        "# TYPE vtfparser_errors_total counter\n"
+        "vtfparser_errors_total{reason=\"InvalidHeader\"} 9\n"
+        "vtfparser_errors_total{reason=\"UnsupportedVersion\"} 0\n"
+        "vtfparser_errors_total{reason=\"OutOfBoundsAccess\"} 0\n"
+        "vtfparser_errors_total{reason=\"UnsupportedImageFormat\"} 0\n"
+        "vtfparser_errors_total{reason=\"InvalidArgument\"} 0\n"
+      )
+    );
+  }
+
+  void jsonIsFormatted() {
+    CHECK(
+      Instrumentation::toJson(makeSnapshot()) == std::string(
+        R"({"vtfConstructions":1,"parseNanoseconds":2,"bytesTouched":3,"cacheHits":4,"cacheMisses":5,)"
+        R"("formats":{"DXT1":{"operations":6,"bytes":7,"nanoseconds":8}},)"
+        R"("errors":{"InvalidHeader":9,"UnsupportedVersion":0,"OutOfBoundsAccess":0,)"
+        R"("UnsupportedImageFormat":0,"InvalidArgument":0}})"
+      )
+    );
+  }
+}
+
+int main() {
+  CHECK(Instrumentation::isEnabled());
+
+  constructionsAndFormatsAreCounted();
+  errorsAreCountedWhereverTheyAreThrown();
+  cacheLookupsAreCounted();
+  exitedThreadsAreKept();
+  prometheusTextIsFormatted();
+  jsonIsFormatted();
+}
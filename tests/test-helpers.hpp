@@ -0,0 +1,71 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <vector>
+#include "../VTFParser.hpp"
+
+#define CHECK(condition) \
+  do { \
+    if (!(condition)) { \
+      std::fprintf(stderr, "%s:%d: check failed: %s\n", __FILE__, __LINE__, #condition); \
+      std::exit(EXIT_FAILURE); \
+    } \
+  } while (false)
+
+#define CHECK_THROWS(expression, error) \
+  do { \
+    try { \
+      static_cast<void>(expression); \
+    } catch (const error&) { \
+      break; \
+    } \
+    std::fprintf(stderr, "%s:%d: expected %s from: %s\n", __FILE__, __LINE__, #error, #expression); \
+    std::exit(EXIT_FAILURE); \
+  } while (false)
+
+namespace VtfParser::Tests {
+  /**
+   * Builds a single-frame 2D VTF with a 16x16 DXT1 low res image, filling the image data with a repeating pattern.
+   */
+  inline std::vector<std::byte> makeVtf(
+    const uint16_t width,
+    const uint16_t height,
+    const ImageFormat format,
+    const uint8_t mipLevels = 1,
+    const TextureFlags flags = TextureFlags::NONE
+  ) {
+    const std::vector<std::byte> lowResImageData(getSliceSizeBytes(FORMAT_TRAITS<ImageFormat::DXT1>, 16, 16));
+
+    size_t highResImageDataSize = 0;
+    for (uint8_t mipLevel = 0; mipLevel < mipLevels; mipLevel++) {
+      highResImageDataSize += getSliceSizeBytes(
+        getFormatTraits(format),
+        std::max(width >> mipLevel, 1),
+        std::max(height >> mipLevel, 1)
+      );
+    }
+
+    std::vector<std::byte> highResImageData(highResImageDataSize);
+    for (size_t i = 0; i < highResImageData.size(); i++) {
+      highResImageData[i] = static_cast<std::byte>(i * 7);
+    }
+
+    return writeVtf(
+      {
+        .highResImageFormat = format,
+        .width = width,
+        .height = height,
+        .flags = flags,
+        .mipLevels = mipLevels,
+        .lowResImageFormat = ImageFormat::DXT1,
+        .lowResImageWidth = 16,
+        .lowResImageHeight = 16,
+        .lowResImageData = lowResImageData,
+        .highResImageData = highResImageData,
+      }
+    );
+  }
+}
@@ -0,0 +1,221 @@
+#include "test-helpers.hpp"
+#include <algorithm>
+#include <utility>
+
+using namespace VtfParser;
+using namespace VtfParser::Errors;
+using namespace VtfParser::Tests;
+
+namespace {
+  /**
+   * Serves ranged reads from memory, recording each read and rejecting any that start past a limit.
+   */
+  struct RecordingReader {
+    std::span<const std::byte> data;
+    size_t limit = SIZE_MAX;
+    std::vector<std::pair<size_t, size_t>> reads = {};
+
+    RangeReader getReader() {
+      return [this](const size_t offset, const std::span<std::byte> buffer) -> size_t {
+        CHECK(offset < limit);
+        reads.emplace_back(offset, buffer.size());
+
+        if (offset >= data.size()) {
+          return 0;
+        }
+
+        const auto count = std::min(buffer.size(), data.size() - offset);
+        std::copy_n(data.begin() + static_cast<ptrdiff_t>(offset), count, buffer.begin());
+        return count;
+      };
+    }
+  };
+
+  size_t getLowResImageOffset(const std::vector<std::byte>& data) {
+    return static_cast<size_t>(Vtf(data).getLowResImageData().data() - data.data());
+  }
+
+  /**
+   * Rewrites a 7.2 VTF from makeVtf() as 7.3, with a resource dictionary.
+   * The low res image is moved to the end of the file so only the resource entry can find it.
+   */
+  std::vector<std::byte> makeResourceVtf(const bool withLowResResource) {
+    auto data = makeVtf(16, 16, ImageFormat::BGRA8888);
+    const auto lowResImageOffset = getLowResImageOffset(data);
+    const auto lowResImageSize = Vtf(data).getLowResImageData().size();
+    const auto highResImageOffset = static_cast<uint32_t>(lowResImageOffset + lowResImageSize);
+
+    Header header{};
+    memcpy(&header, data.data(), sizeof(Header));
+
+    const auto movedLowResImageOffset = static_cast<uint32_t>(data.size());
+    data.insert(data.end(), lowResImageSize, std::byte{0xab});
+
+    header.version[1] = 3;
+    header.numResources = withLowResResource ? 2 : 1;
+    header.headerSize = static_cast<uint32_t>(sizeof(HeaderFullAligned) + 8 + header.numResources * 8);
+    header.resourceInfos[0] = {.tag = {0x30, 0, 0}, .flags = 0, .data = highResImageOffset};
+    header.resourceInfos[1] = {.tag = {0x01, 0, 0}, .flags = 0, .data = movedLowResImageOffset};
+    memcpy(data.data(), &header, sizeof(Header));
+
+    return data;
+  }
+
+  void thumbnailIsReadWithTwoReads() {
+    const auto data = makeVtf(64, 64, ImageFormat::BGRA8888, 7);
+    const Vtf vtf(data);
+    const auto lowResImageOffset = getLowResImageOffset(data);
+    const auto lowResImageSize = vtf.getLowResImageData().size();
+
+    RecordingReader reader = {.data = data, .limit = lowResImageOffset + lowResImageSize};
+    const auto thumbnail = readThumbnail(reader.getReader());
+
+    CHECK(reader.reads.size() == 2);
+    CHECK(reader.reads[0] == std::pair(size_t{0}, sizeof(Header)));
+    CHECK(reader.reads[1] == std::pair(lowResImageOffset, lowResImageSize));
+
+    CHECK(thumbnail.format == ImageFormat::DXT1);
+    CHECK(thumbnail.width == 16 && thumbnail.height == 16);
+    CHECK(std::ranges::equal(thumbnail.data, vtf.getLowResImageData()));
+
+    const auto fromMemory = readThumbnail(std::span<const std::byte>(data));
+    CHECK(fromMemory.format == thumbnail.format && fromMemory.data == thumbnail.data);
+  }
+
+  void thumbnailIsFoundThroughResources() {
+    const auto data = makeResourceVtf(true);
+
+    RecordingReader reader = {.data = data};
+    const auto thumbnail = readThumbnail(reader.getReader());
+
+    CHECK(reader.reads.size() == 2);
+    CHECK(reader.reads[1].first == data.size() - thumbnail.data.size());
+    CHECK(thumbnail.format == ImageFormat::DXT1);
+    CHECK(thumbnail.data.size() == 128);
+    CHECK(std::ranges::all_of(thumbnail.data, [](const std::byte value) { return value == std::byte{0xab}; }));
+  }
+
+  void missingThumbnailsAreEmpty() {
+    const auto withoutResource = makeResourceVtf(false);
+    RecordingReader reader = {.data = withoutResource};
+    const auto thumbnail = readThumbnail(reader.getReader());
+
+    CHECK(reader.reads.size() == 1);
+    CHECK(thumbnail.format == ImageFormat::NONE && thumbnail.data.empty());
+
+    const std::vector<std::byte> highResImageData(4 * 4 * 4);
+    const auto withoutLowResImage = writeVtf(
+      {.highResImageFormat = ImageFormat::RGBA8888, .width = 4, .height = 4, .highResImageData = highResImageData}
+    );
+    RecordingReader lowResReader = {.data = withoutLowResImage};
+    CHECK(readThumbnail(lowResReader.getReader()).format == ImageFormat::NONE);
+    CHECK(lowResReader.reads.size() == 1);
+  }
+
+  void shortReadsThrow() {
+    const auto data = makeVtf(16, 16, ImageFormat::BGRA8888);
+    const auto lowResImageOffset = getLowResImageOffset(data);
+
+    const std::span<const std::byte> truncated(data.data(), lowResImageOffset + 100);
+    CHECK_THROWS(readThumbnail(truncated), OutOfBoundsAccess);
+    CHECK_THROWS(readThumbnail(std::span(data.data(), 40)), OutOfBoundsAccess);
+  }
+
+  void thumbnailsDecode() {
+    const auto data = makeVtf(16, 16, ImageFormat::BGRA8888);
+    const std::vector thumbnails = {
+      readThumbnail(std::span<const std::byte>(data)),
+      Thumbnail{.format = ImageFormat::NONE, .width = 0, .height = 0, .data = {}},
+    };
+
+    const auto images = decodeThumbnails(thumbnails, 2);
+    CHECK(images.size() == 2);
+    CHECK(images[0].width == 16 && images[0].height == 16 && images[0].pixels.size() == 16 * 16 * 4);
+    CHECK(images[1].width == 0 && images[1].height == 0 && images[1].pixels.empty());
+  }
+
+  void decodeErrorsReachTheCaller() {
+    // Each thumbnail is decoded on whichever thread picks up its range, so these throw on the workers
+    const std::vector<Thumbnail> empty(8, {.format = ImageFormat::DXT1, .width = 0, .height = 0, .data = {}});
+    CHECK_THROWS(decodeThumbnails(empty, 4), OutOfBoundsAccess);
+
+    std::vector<Thumbnail> thumbnails(8, {.format = ImageFormat::NONE, .width = 0, .height = 0, .data = {}});
+    thumbnails[5] = {.format = ImageFormat::P8, .width = 1, .height = 1, .data = std::vector<std::byte>(1)};
+    CHECK_THROWS(decodeThumbnails(thumbnails, 4), UnsupportedImageFormat);
+
+    thumbnails[5] = {.format = ImageFormat::RGBA8888, .width = 2, .height = 2, .data = std::vector<std::byte>(15)};
+    CHECK_THROWS(decodeThumbnails(thumbnails, 4), OutOfBoundsAccess);
+  }
+
+  void contactSheetsSpanSheets() {
+    constexpr std::array<std::pair<size_t, size_t>, 5> sizes = {{{3, 2}, {1, 1}, {2, 3}, {3, 3}, {2, 2}}};
+    std::vector<Rgba8Image> images;
+    for (size_t i = 0; i < sizes.size(); i++) {
+      const auto [width, height] = sizes[i];
+      const auto value = static_cast<uint8_t>(i + 1);
+      images.push_back({.width = width, .height = height, .pixels = std::vector(width * height * 4, value)});
+    }
+
+    const auto contactSheets = buildContactSheets(images, {.columns = 2, .rows = 2, .threadCount = 2});
+
+    // Cells take the largest image size; four fit on the first sheet and the last image starts a second
+    CHECK(contactSheets.sheets.size() == 2);
+    CHECK(contactSheets.sheets[0].width == 6 && contactSheets.sheets[0].height == 6);
+    CHECK(contactSheets.sheets[1].width == 3 && contactSheets.sheets[1].height == 3);
+
+    constexpr std::array<std::array<size_t, 3>, 5> expectedCells = {{
+      {0, 0, 0},
+      {0, 3, 0},
+      {0, 0, 3},
+      {0, 3, 3},
+      {1, 0, 0},
+    }};
+    CHECK(contactSheets.cells.size() == images.size());
+    for (size_t i = 0; i < images.size(); i++) {
+      const auto& cell = contactSheets.cells[i];
+      CHECK(cell.sheet == expectedCells[i][0] && cell.x == expectedCells[i][1] && cell.y == expectedCells[i][2]);
+    }
+
+    // Every pixel belongs to the image placed in the top left of its cell, or is transparent black
+    for (size_t sheetIndex = 0; sheetIndex < contactSheets.sheets.size(); sheetIndex++) {
+      const auto& sheet = contactSheets.sheets[sheetIndex];
+      for (size_t y = 0; y < sheet.height; y++) {
+        for (size_t x = 0; x < sheet.width; x++) {
+          uint8_t expected = 0;
+          for (size_t i = 0; i < images.size(); i++) {
+            const auto& cell = contactSheets.cells[i];
+            const bool inImage = cell.sheet == sheetIndex
+              && x >= cell.x && x < cell.x + images[i].width
+              && y >= cell.y && y < cell.y + images[i].height;
+            if (inImage) {
+              expected = static_cast<uint8_t>(i + 1);
+            }
+          }
+
+          const auto* pixel = sheet.pixels.data() + (y * sheet.width + x) * 4;
+          CHECK(std::all_of(pixel, pixel + 4, [expected](const uint8_t value) { return value == expected; }));
+        }
+      }
+    }
+  }
+
+  void invalidContactSheetsThrow() {
+    const std::vector<Rgba8Image> images = {{.width = 4, .height = 2, .pixels = std::vector<uint8_t>(4 * 2 * 4)}};
+
+    CHECK_THROWS(buildContactSheets(images, {.columns = 0}), InvalidArgument);
+    CHECK_THROWS(buildContactSheets(images, {.rows = 0}), InvalidArgument);
+    CHECK_THROWS(buildContactSheets(images, {.cellWidth = 3}), InvalidArgument);
+    CHECK_THROWS(buildContactSheets(images, {.cellHeight = 1}), InvalidArgument);
+  }
+}
+
+int main() {
+  thumbnailIsReadWithTwoReads();
+  thumbnailIsFoundThroughResources();
+  missingThumbnailsAreEmpty();
+  shortReadsThrow();
+  thumbnailsDecode();
+  decodeErrorsReachTheCaller();
+  contactSheetsSpanSheets();
+  invalidContactSheetsThrow();
+}
@@ -0,0 +1,115 @@
+#include "test-helpers.hpp"
+#include <algorithm>
+
+using namespace VtfParser;
+using namespace VtfParser::Tests;
+
+namespace {
+  void writtenVtfParses() {
+    const auto data = makeVtf(32, 16, ImageFormat::BGRA8888, 6, TextureFlags::CLAMPS | TextureFlags::NOLOD);
+    const Vtf vtf(data);
+
+    CHECK(vtf.getHighResImageFormat() == ImageFormat::BGRA8888);
+    CHECK(vtf.getHighResImageExtent().width == 32);
+    CHECK(vtf.getHighResImageExtent().height == 16);
+    CHECK(vtf.getMipLevels() == 6);
+    CHECK(vtf.getFlags() == (TextureFlags::CLAMPS | TextureFlags::NOLOD));
+    CHECK(vtf.getLowResImageFormat() == ImageFormat::DXT1);
+    CHECK(vtf.getLowResImageData().size() == 128);
+    CHECK(vtf.getHighResImageData().size() == (32 * 16 + 16 * 8 + 8 * 4 + 4 * 2 + 2 * 1 + 1) * 4);
+    CHECK(vtf.getImageSliceData(5).data() == vtf.getHighResImageData().data());
+  }
+
+  void writtenVtfWithoutLowResImageParses() {
+    const std::vector<std::byte> highResImageData(8 * 8 * 3);
+    const auto data = writeVtf(
+      {
+        .highResImageFormat = ImageFormat::RGB888,
+        .width = 8,
+        .height = 8,
+        .highResImageData = highResImageData,
+      }
+    );
+    const Vtf vtf(data);
+
+    CHECK(vtf.getLowResImageFormat() == ImageFormat::NONE);
+    CHECK(vtf.getLowResImageData().empty());
+    CHECK(vtf.getHighResImageData().size() == highResImageData.size());
+  }
+
+  void mismatchedDataSizeThrows() {
+    const std::vector<std::byte> highResImageData(10);
+    CHECK_THROWS(
+      writeVtf({.highResImageFormat = ImageFormat::RGB888, .width = 8, .height = 8, .highResImageData = highResImageData}),
+      Errors::InvalidArgument
+    );
+  }
+
+  void resampledVtfParses() {
+    const auto data = makeVtf(64, 32, ImageFormat::RGBA8888, 7, TextureFlags::SRGB);
+    const Vtf source(data);
+
+    const auto resampledData = resampleVtf(source, 16, 8);
+    const Vtf resampled(resampledData);
+
+    CHECK(resampled.getHighResImageExtent().width == 16);
+    CHECK(resampled.getHighResImageExtent().height == 8);
+    CHECK(resampled.getMipLevels() == 5);
+    CHECK(resampled.getFlags() == source.getFlags());
+    CHECK(std::ranges::equal(resampled.getLowResImageData(), source.getLowResImageData()));
+  }
+
+  void resampledVtfWithoutLowResImageParses() {
+    const std::vector<std::byte> highResImageData(8 * 8 * 4);
+    const auto data = writeVtf(
+      {
+        .highResImageFormat = ImageFormat::RGBA8888,
+        .width = 8,
+        .height = 8,
+        .highResImageData = highResImageData,
+      }
+    );
+    const Vtf source(data);
+
+    const auto resampledData = resampleVtf(source, 4, 4);
+    const Vtf resampled(resampledData);
+
+    CHECK(resampled.getLowResImageFormat() == ImageFormat::NONE);
+    CHECK(resampled.getLowResImageData().empty());
+    CHECK(resampled.getHighResImageExtent().width == 4);
+  }
+
+  void resampledNoMipVtfUsesFirstMipLevel() {
+    // Mip 1 is black and mip 0 is grey, so the output shows which level was sampled
+    std::vector<std::byte> highResImageData(16 * 16 * 4 + 32 * 32 * 4);
+    std::fill(highResImageData.begin() + 16 * 16 * 4, highResImageData.end(), std::byte{200});
+    const auto data = writeVtf(
+      {
+        .highResImageFormat = ImageFormat::RGBA8888,
+        .width = 32,
+        .height = 32,
+        .flags = TextureFlags::NOMIP,
+        .mipLevels = 2,
+        .highResImageData = highResImageData,
+      }
+    );
+    const Vtf source(data);
+
+    const auto resampledData = resampleVtf(source, 16, 16, {.linearise = false});
+    const Vtf resampled(resampledData);
+
+    CHECK(resampled.getMipLevels() == 1);
+    CHECK(std::ranges::all_of(resampled.getHighResImageData(), [](const std::byte value) {
+      return value == std::byte{200};
+    }));
+  }
+}
+
+int main() {
+  writtenVtfParses();
+  writtenVtfWithoutLowResImageParses();
+  mismatchedDataSizeThrows();
+  resampledVtfParses();
+  resampledVtfWithoutLowResImageParses();
+  resampledNoMipVtfUsesFirstMipLevel();
+}